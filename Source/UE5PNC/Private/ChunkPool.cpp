@@ -0,0 +1,131 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#include "ChunkPool.h"
+
+namespace PNC
+{
+    /// <summary>
+    /// Free blocks owned by a single thread. Given back to the shared pool when the thread exits.
+    /// </summary>
+    struct ChunkPool::ThreadCache
+    {
+        FreeListMap_t Lists;
+
+        ~ThreadCache()
+        {
+            ChunkPool::Get().ReleaseToShared(Lists);
+        }
+    };
+
+    ChunkPool::ChunkPool()
+        : PooledBytes(0)
+    {
+    }
+
+    ChunkPool::~ChunkPool()
+    {
+        FreeBlocks(Shared, nullptr);
+    }
+
+    ChunkPool& ChunkPool::Get()
+    {
+        static ChunkPool pool;
+        return pool;
+    }
+
+    ChunkPool::ThreadCache& ChunkPool::GetThreadCache()
+    {
+        static thread_local ThreadCache cache;
+        return cache;
+    }
+
+    void* ChunkPool::Allocate(const Key& key)
+    {
+        FreeList_t& blocks = GetThreadCache().Lists[key];
+        if (blocks.empty())
+        {
+            // Refill half of the thread cache at once so the lock is taken rarely.
+            FScopeLock scopeLock(&Lock);
+            auto i = Shared.find(key);
+            if (i != Shared.end())
+            {
+                FreeList_t& shared = i->second;
+                SIZE_T count = FMath::Min<SIZE_T>(shared.size(), FMath::Max(1, MaxThreadCacheBlocks / 2));
+                blocks.insert(blocks.end(), shared.end() - count, shared.end());
+                shared.resize(shared.size() - count);
+            }
+        }
+        if (blocks.empty())
+            return FMemory::Malloc(key.Size, key.Alignment);
+        void* ptr = blocks.back();
+        blocks.pop_back();
+        PooledBytes.fetch_sub(key.Size, std::memory_order_relaxed);
+        return ptr;
+    }
+
+    void ChunkPool::Deallocate(const Key& key, void* ptr)
+    {
+        if (ptr == nullptr)
+            return;
+        FreeList_t& blocks = GetThreadCache().Lists[key];
+        blocks.push_back(ptr);
+        PooledBytes.fetch_add(key.Size, std::memory_order_relaxed);
+        if ((int32)blocks.size() > MaxThreadCacheBlocks)
+        {
+            // Give half of the thread cache back so other threads can reuse it.
+            SIZE_T count = blocks.size() / 2;
+            FScopeLock scopeLock(&Lock);
+            FreeList_t& shared = Shared[key];
+            shared.insert(shared.end(), blocks.end() - count, blocks.end());
+            blocks.resize(blocks.size() - count);
+        }
+    }
+
+    void ChunkPool::Trim()
+    {
+        FreeBlocks(GetThreadCache().Lists, nullptr);
+        FScopeLock scopeLock(&Lock);
+        FreeBlocks(Shared, nullptr);
+    }
+
+    void ChunkPool::Trim(const void* chunkStructure)
+    {
+        assert_pnc(chunkStructure != nullptr);
+        FreeBlocks(GetThreadCache().Lists, chunkStructure);
+        FScopeLock scopeLock(&Lock);
+        FreeBlocks(Shared, chunkStructure);
+    }
+
+    void ChunkPool::FlushThreadCache()
+    {
+        ReleaseToShared(GetThreadCache().Lists);
+    }
+
+    void ChunkPool::ReleaseToShared(FreeListMap_t& lists)
+    {
+        FScopeLock scopeLock(&Lock);
+        for (auto& entry : lists)
+        {
+            FreeList_t& shared = Shared[entry.first];
+            shared.insert(shared.end(), entry.second.begin(), entry.second.end());
+        }
+        lists.clear();
+    }
+
+    void ChunkPool::FreeBlocks(FreeListMap_t& lists, const void* chunkStructure)
+    {
+        for (auto i = lists.begin(); i != lists.end();)
+        {
+            if (chunkStructure != nullptr && i->first.ChunkStructure != chunkStructure)
+            {
+                ++i;
+                continue;
+            }
+            for (void* ptr : i->second)
+                FMemory::Free(ptr);
+            PooledBytes.fetch_sub(i->first.Size * i->second.size(), std::memory_order_relaxed);
+            i = lists.erase(i);
+        }
+    }
+}
@@ -0,0 +1,56 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#include "ChunkStats.h"
+#include "Misc/FileHelper.h"
+
+namespace PNC
+{
+    ChunkStatsRegistry& ChunkStatsRegistry::Get()
+    {
+        static ChunkStatsRegistry registry;
+        return registry;
+    }
+
+    void ChunkStatsRegistry::Register(const void* chunkStructure, const ChunkStructureStats* stats, const FString& name)
+    {
+        FScopeLock scopeLock(&Lock);
+        Entries.push_back(Entry{ chunkStructure, stats, name });
+    }
+
+    void ChunkStatsRegistry::Unregister(const void* chunkStructure)
+    {
+        FScopeLock scopeLock(&Lock);
+        Entries.erase(std::remove_if(Entries.begin(), Entries.end(), [chunkStructure](const Entry& entry) { return entry.ChunkStructure == chunkStructure; }), Entries.end());
+    }
+
+    std::vector<ChunkStatsRegistry::Entry> ChunkStatsRegistry::GetEntries()const
+    {
+        FScopeLock scopeLock(&Lock);
+        return Entries;
+    }
+
+    FString ChunkStatsRegistry::GetReport()const
+    {
+        FString report(TEXT("Structure,LiveChunks,CommittedBytes,PeakBytes,NodeCount,NodeCapacity,Occupancy"));
+        for (int32 i = 0; i < ChunkStructureStats::OccupancyBucketCount; ++i)
+            report += FString::Printf(TEXT(",Occupancy%d-%d%%"), i * 100 / ChunkStructureStats::OccupancyBucketCount, (i + 1) * 100 / ChunkStructureStats::OccupancyBucketCount);
+        report += TEXT("\n");
+        for (const Entry& entry : GetEntries())
+        {
+            ChunkStructureStats::Snapshot snapshot = entry.Stats->GetSnapshot();
+            report += FString::Printf(TEXT("%s,%lld,%lld,%lld,%lld,%lld,%.3f"), *entry.Name,
+                (long long)snapshot.LiveChunks, (long long)snapshot.CommittedBytes, (long long)snapshot.PeakBytes,
+                (long long)snapshot.NodeCount, (long long)snapshot.NodeCapacity, snapshot.GetOccupancy());
+            for (int64 count : snapshot.OccupancyHistogram)
+                report += FString::Printf(TEXT(",%lld"), (long long)count);
+            report += TEXT("\n");
+        }
+        return report;
+    }
+
+    bool ChunkStatsRegistry::DumpToFile(const FString& filename)const
+    {
+        return FFileHelper::SaveStringToFile(GetReport(), *filename);
+    }
+}
@@ -0,0 +1,47 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#include "ComponentRegistry.h"
+
+namespace PNC
+{
+    ComponentRegistry& ComponentRegistry::Get()
+    {
+        static ComponentRegistry registry;
+        return registry;
+    }
+
+    ComponentId ComponentRegistry::Register(const type_info* type)
+    {
+        FScopeLock scopeLock(&Lock);
+        auto i = TypeToId.find(std::type_index(*type));
+        if (i != TypeToId.end())
+            return i->second;
+        ComponentId id = (ComponentId)Types.size();
+        TypeToId.emplace(std::type_index(*type), id);
+        Types.push_back(type);
+        return id;
+    }
+
+    ComponentId ComponentRegistry::Find(const type_info* type)const
+    {
+        FScopeLock scopeLock(&Lock);
+        auto i = TypeToId.find(std::type_index(*type));
+        if (i == TypeToId.end())
+            return -1;
+        return i->second;
+    }
+
+    ComponentId ComponentRegistry::GetCount()const
+    {
+        FScopeLock scopeLock(&Lock);
+        return (ComponentId)Types.size();
+    }
+
+    const type_info* ComponentRegistry::GetTypeInfo(ComponentId id)const
+    {
+        FScopeLock scopeLock(&Lock);
+        assert_pnc(id >= 0 && id < (ComponentId)Types.size());
+        return Types[id];
+    }
+}
@@ -3,6 +3,9 @@
 
 #pragma once
 #include "common.h"
+#include "AlignedColumn.h"
+#include "SplitColumn.h"
+#include "ParentGather.h"
 
 namespace PNC
 {
@@ -28,6 +31,24 @@ namespace PNC
             return false;
         }
 
+        /// <summary>
+        /// Get access to a specific component column in the current chunk with an alignment guarantee.
+        /// </summary>
+        template<typename TComponent, SIZE_T TAlignment>
+        bool Component(AlignedColumnT<TComponent, TAlignment>& column)
+        {
+            return false;
+        }
+
+        /// <summary>
+        /// Get access to the column of a split component in the current chunk.
+        /// </summary>
+        template<typename TComponent>
+        bool Component(SplitColumnT<TComponent>& column)
+        {
+            return false;
+        }
+
         /// <summary>
         /// Get access to a specific component in the parent chunk.
         /// </summary>
@@ -40,6 +61,15 @@ namespace PNC
             return false;
         }
 
+        /// <summary>
+        /// Get the parent Component values of every node in the current chunk, gathered from the parent chunk.
+        /// </summary>
+        template<typename TComponent>
+        bool ParentComponent(ParentGatherT<TComponent>& gather)
+        {
+            return false;
+        }
+
         /// <summary>
         /// Get the current chunk index when processing arrays of chunks
         /// </summary>
@@ -4,6 +4,7 @@
 #pragma once
 #include "common.h"
 #include "AlgorithmRunnerKindPointerSwitch.h"
+#include "AlgorithmRunnerChunkTree.h"
 
 namespace PNC
 {
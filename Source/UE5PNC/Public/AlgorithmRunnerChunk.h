@@ -5,6 +5,14 @@
 #include "common.h"
 #include "Routing\SetAlgorithmChunk.h"
 #include "Routing\OffsetAlgorithmNode.h"
+#include "Routing\SkipAlgorithmNode.h"
+#include "Routing\AlgorithmNodeMultiple.h"
+#include "NodeOccupancy.h"
+#include "ChunkSlice.h"
+#include "NodeSelection.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include <atomic>
 
 namespace PNC
 {
@@ -22,6 +30,15 @@ namespace PNC
         using Self_t = AlgorithmRunnerChunk<TAlgorithm, TChunkPointer>;
         using Algorithm_t = TAlgorithm;
         using ChunkPointer_t = TChunkPointer;
+        using ChunkStructure_t = typename TChunkPointer::ChunkStructure_t;
+        using Size_t = typename TChunkPointer::Size_t;
+        using ChunkSlice_t = ChunkSliceT<ChunkStructure_t>;
+        using NodeSelection_t = NodeSelectionT<Size_t>;
+
+        /// <summary>
+        /// Default number of Nodes per range when splitting a Chunk with TryRunParallel.
+        /// </summary>
+        static constexpr Size_t DefaultRangeSize = 16 * 1024;
 
     public:
         /// <summary>
@@ -37,7 +54,184 @@ namespace PNC
                 return false;
             if (!algorithm.Requirements(Routing::SetAlgorithmChunk<ChunkPointer_t>(&chunkPtr)))
                 return false;
-            algorithm.Execute(chunk.GetNodeCount());
+            return ExecuteNodes(algorithm, chunk);
+        }
+
+        /// <summary>
+        /// Execute an already routed algorithm on the nodes of a chunk.
+        /// If the chunk has an occupancy bitmap, the algorithm is executed once per range of alive nodes
+        /// and its node component pointers are moved back to the beginning of the chunk afterward.
+        /// When its AlignedColumnT requirements do not allow the ranges, see CanExecuteRanges, an algorithm declaring
+        /// Execute(Size_t nodeCount, const NodeSelectionT<Size_t>& selection) is executed once on the alive nodes instead.
+        /// </summary>
+        /// <param name="algorithm"></param>
+        /// <param name="chunk"></param>
+        /// <returns>False if the algorithm was not executed because its AlignedColumnT requirements do not allow the ranges.</returns>
+        template<typename TChunk>
+        static bool ExecuteNodes(TAlgorithm& algorithm, const TChunk& chunk)
+        {
+            const uint64* occupancy = chunk.GetOccupancy();
+            if (occupancy == nullptr)
+            {
+                algorithm.Execute(chunk.GetNodeCount());
+                return true;
+            }
+            NodeSelection_t alive = NodeSelection_t::FromMask(occupancy, chunk.GetNodeCount());
+            if (CanExecuteRanges(algorithm, alive))
+                ExecuteRanges(algorithm, alive);
+            else if constexpr (HasSelectionExecute<TAlgorithm, Size_t>::value)
+                algorithm.Execute(chunk.GetNodeCount(), alive);
+            else
+                return false;
+            return true;
+        }
+
+        /// <summary>
+        /// Route and execute an algorithm on the selected nodes of a chunk.
+        /// </summary>
+        /// <param name="algorithm"></param>
+        /// <param name="chunkPtr"></param>
+        /// <param name="selection">Nodes to process, covering the chunk's node count.</param>
+        /// <returns>If the chunk fulfilled the algorithm requirements.</returns>
+        static bool TryRunSelected(TAlgorithm& algorithm, ChunkPointer_t& chunkPtr, const NodeSelection_t& selection)
+        {
+            auto& chunk = *chunkPtr;
+            if (chunk.IsNull())
+                return false;
+            if (!algorithm.Requirements(Routing::SetAlgorithmChunk<ChunkPointer_t>(&chunkPtr)))
+                return false;
+            return ExecuteNodesSelected(algorithm, chunk, selection);
+        }
+
+        /// <summary>
+        /// Execute an already routed algorithm on the selected nodes of a chunk. Dead nodes of the chunk's occupancy bitmap are never selected.
+        /// An algorithm declaring Execute(Size_t nodeCount, const NodeSelectionT<Size_t>& selection) is executed once with the selection
+        /// and processes the selected nodes itself, with masked SIMD lanes or a dense index loop.
+        /// Other algorithms are executed once per range of consecutive selected nodes.
+        /// </summary>
+        /// <param name="algorithm"></param>
+        /// <param name="chunk"></param>
+        /// <param name="selection">Nodes to process, covering the chunk's node count.</param>
+        /// <returns>False if the algorithm was not executed because its AlignedColumnT requirements do not allow the ranges, see CanExecuteRanges.</returns>
+        template<typename TChunk>
+        static bool ExecuteNodesSelected(TAlgorithm& algorithm, const TChunk& chunk, const NodeSelection_t& selection)
+        {
+            assert_pnc(selection.NodeCount == chunk.GetNodeCount());
+            std::vector<uint64> maskStorage;
+            std::vector<Size_t> indexStorage;
+            const uint64* occupancy = chunk.GetOccupancy();
+            NodeSelection_t alive = occupancy == nullptr ? selection : selection.Intersect(occupancy, maskStorage, indexStorage);
+            if constexpr (HasSelectionExecute<TAlgorithm, Size_t>::value)
+                algorithm.Execute(chunk.GetNodeCount(), alive);
+            else
+            {
+                if (!CanExecuteRanges(algorithm, alive))
+                    return false;
+                ExecuteRanges(algorithm, alive);
+            }
+            return true;
+        }
+
+        /// <summary>
+        /// If an algorithm can be executed once per range of consecutive selected nodes.
+        /// An algorithm with AlignedColumnT requirements can only be executed on ranges starting on a multiple of their NodeMultiple
+        /// and ending on one or on the chunk's node count, so each range starts aligned and its padding stays within the range.
+        /// </summary>
+        static bool CanExecuteRanges(TAlgorithm& algorithm, const NodeSelection_t& selection)
+        {
+            SSIZE_T nodeMultiple = Routing::GetAlgorithmNodeMultiple(algorithm);
+            if (nodeMultiple <= 1)
+                return true;
+            bool bAligned = true;
+            selection.ForEachRange([&](Size_t begin, Size_t end)
+                {
+                    bAligned &= begin % nodeMultiple == 0 && (end % nodeMultiple == 0 || end == selection.NodeCount);
+                });
+            return bAligned;
+        }
+
+        /// <summary>
+        /// Execute an already routed algorithm once per range of consecutive selected nodes.
+        /// The algorithm's node component pointers are moved to each range then back to the beginning of the chunk.
+        /// </summary>
+        static void ExecuteRanges(TAlgorithm& algorithm, const NodeSelection_t& selection)
+        {
+            Size_t cursor = 0;
+            selection.ForEachRange([&](Size_t begin, Size_t end)
+                {
+                    algorithm.Requirements(Routing::SkipAlgorithmNode<ChunkPointer_t>(begin - cursor));
+                    cursor = begin;
+                    algorithm.Execute(end - begin);
+                });
+            algorithm.Requirements(Routing::SkipAlgorithmNode<ChunkPointer_t>(-cursor));
+        }
+
+        /// <summary>
+        /// Route an algorithm on a chunk and execute copies of it on ranges of the chunk's nodes from worker threads.
+        /// The nodes are split in ranges of rangeSize nodes. Each worker owns a copy of the routed algorithm
+        /// and keeps taking the next range until none is left.
+        /// The algorithm's Execute must only write to the nodes it is executed on.
+        /// </summary>
+        /// <param name="algorithm">Algorithm to route, copied once per worker. Left bound to the chunk.</param>
+        /// <param name="chunkPtr"></param>
+        /// <param name="rangeSize">Number of nodes a worker processes at once, rounded up to a multiple of ChunkSlice_t::OccupancyGranularity
+        /// and of the NodeMultiple of the algorithm's AlignedColumnT requirements.</param>
+        /// <param name="outWorkerAlgorithms">Optional vector receiving the algorithm copy of each worker, to reduce per worker results.</param>
+        /// <returns>If the chunk fulfilled the algorithm requirements.</returns>
+        static bool TryRunParallel(TAlgorithm& algorithm, ChunkPointer_t& chunkPtr, Size_t rangeSize = DefaultRangeSize, std::vector<TAlgorithm>* outWorkerAlgorithms = nullptr)
+        {
+            auto& chunk = *chunkPtr;
+            if (chunk.IsNull())
+                return false;
+            if (!algorithm.Requirements(Routing::SetAlgorithmChunk<ChunkPointer_t>(&chunkPtr)))
+                return false;
+            return ExecuteNodesParallel(algorithm, chunk, rangeSize, outWorkerAlgorithms);
+        }
+
+        /// <summary>
+        /// Execute copies of an already routed algorithm on ranges of the nodes of a chunk from worker threads.
+        /// Each range is a ChunkSlice of the chunk and the worker's algorithm is moved to it with SkipAlgorithmNode,
+        /// so parent, children and chunk component bindings are kept and no component lookup is done per range.
+        /// Ranges start on a multiple of the occupancy granularity so a chunk with an occupancy bitmap can be split too.
+        /// </summary>
+        /// <param name="algorithm">Routed algorithm, copied once per worker.</param>
+        /// <param name="chunk"></param>
+        /// <param name="rangeSize">Number of nodes a worker processes at once.</param>
+        /// <param name="outWorkerAlgorithms">Optional vector receiving the algorithm copy of each worker.</param>
+        /// <returns>False if the algorithm was not executed because its AlignedColumnT requirements do not allow the alive ranges of the chunk.</returns>
+        template<typename TChunk>
+        static bool ExecuteNodesParallel(TAlgorithm& algorithm, const TChunk& chunk, Size_t rangeSize, std::vector<TAlgorithm>* outWorkerAlgorithms = nullptr)
+        {
+            // Both are powers of two, ranges start on a multiple of the larger one.
+            Size_t granularity = FMath::Max((Size_t)ChunkSlice_t::OccupancyGranularity, (Size_t)Routing::GetAlgorithmNodeMultiple(algorithm));
+            assert_pnc(rangeSize > 0);
+            rangeSize = (rangeSize + granularity - 1) / granularity * granularity;
+            Size_t nodeCount = chunk.GetNodeCount();
+            // Check every alive range up front so the chunk is either processed entirely or not at all.
+            if constexpr (!HasSelectionExecute<TAlgorithm, Size_t>::value)
+                if (chunk.GetOccupancy() != nullptr && !CanExecuteRanges(algorithm, NodeSelection_t::FromMask(chunk.GetOccupancy(), nodeCount)))
+                    return false;
+            Size_t rangeCount = (nodeCount + rangeSize - 1) / rangeSize;
+            Size_t workerCount = FMath::Min(rangeCount, (Size_t)FTaskGraphInterface::Get().GetNumWorkerThreads() + 1);
+            std::vector<TAlgorithm> localWorkerAlgorithms;
+            std::vector<TAlgorithm>& workerAlgorithms = outWorkerAlgorithms != nullptr ? *outWorkerAlgorithms : localWorkerAlgorithms;
+            workerAlgorithms.assign(workerCount, algorithm);
+            std::atomic<Size_t> nextRange(0);
+            ParallelFor(workerCount, [&](int32 workerIndex)
+                {
+                    TAlgorithm& workerAlgorithm = workerAlgorithms[workerIndex];
+                    ChunkSlice_t slice;
+                    Size_t cursor = 0;
+                    for (Size_t range = nextRange.fetch_add(1, std::memory_order_relaxed); range < rangeCount; range = nextRange.fetch_add(1, std::memory_order_relaxed))
+                    {
+                        Size_t begin = range * rangeSize;
+                        slice.Reset(chunk, begin, FMath::Min(rangeSize, nodeCount - begin));
+                        workerAlgorithm.Requirements(Routing::SkipAlgorithmNode<ChunkPointer_t>(begin - cursor));
+                        cursor = begin;
+                        ExecuteNodes(workerAlgorithm, slice);
+                    }
+                    workerAlgorithm.Requirements(Routing::SkipAlgorithmNode<ChunkPointer_t>(-cursor));
+                });
             return true;
         }
 
@@ -56,8 +250,7 @@ namespace PNC
             assert_pnc(!chunk.IsNull());
             if (!router.RouteAlgorithm(algorithm, chunkPtr))
                 return false;
-            algorithm.Execute(chunk.GetNodeCount());
-            return true;
+            return ExecuteNodes(algorithm, chunk);
         }
     };
 }
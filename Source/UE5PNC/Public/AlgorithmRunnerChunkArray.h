@@ -4,12 +4,19 @@
 #pragma once
 #include "common.h"
 #include "Routing\SetAlgorithmChunk.h"
-#include "Routing\OffsetAlgorithmNode.h"
+#include "Routing\AlgorithmCacheRouter.h"
+#include "Routing\BindAlgorithmChunkElement.h"
+#include "AlgorithmRunnerChunk.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include <atomic>
 
 namespace PNC
 {
     /// <summary>
     /// Execute an algorithm on each element Chunks in Chunk array.
+    /// The algorithm is routed once on the array then bound to each element Chunk in constant time,
+    /// so element Chunks can also be distributed over worker threads with TryRunParallel.
     /// </summary>
     /// <typeparam name="TAlgorithm"></typeparam>
     /// <typeparam name="TChunkArrayPointer"></typeparam>
@@ -20,7 +27,10 @@ namespace PNC
         using Algorithm_t = TAlgorithm;
         using ChunkArrayPointer_t = TChunkArrayPointer;
         using ChunkStructure_t = typename TChunkArrayPointer::ChunkStructure_t;
+        using ChunkPointerElement_t = typename TChunkArrayPointer::ChunkPointerElement_t;
         using Size_t = typename TChunkArrayPointer::Size_t;
+        using ChunkRunner_t = AlgorithmRunnerChunk<TAlgorithm, TChunkArrayPointer>;
+        using Route_t = Routing::RouteT<Size_t>;
 
     public:
         /// <summary>
@@ -28,33 +38,30 @@ namespace PNC
         /// </summary>
         /// <param name="algorithm"></param>
         /// <param name="chunkPtr"></param>
-        /// <returns></returns>
+        /// <returns>False if the array did not fulfill the algorithm requirements or an element Chunk was skipped, see ExecuteElement.</returns>
         static bool TryRun(Algorithm_t& algorithm, ChunkArrayPointer_t& chunkPtr)
         {
             auto& chunkArray = *chunkPtr;
             if (chunkArray.IsNull())
                 return false;
-            if (!algorithm.Requirements(Routing::SetAlgorithmChunk<ChunkArrayPointer_t>(&chunkPtr)))
+            Route_t route;
+            if (!RouteArray(algorithm, chunkPtr, route))
                 return false;
+            bool bExecuted = true;
             for (Size_t i = 0; i < chunkArray.GetChunkCount(); ++i)
-            {
-                auto& chunk = chunkArray[i];
-                auto nodeCount = chunk.GetNodeCount();
-                algorithm.Execute(nodeCount);
-                if (!algorithm.Requirements(Routing::OffsetAlgorithmNode<ChunkArrayPointer_t>(nodeCount)))
-                    return false;
-            }
-            return true;
+                bExecuted &= ExecuteElement(algorithm, chunkArray, route, i);
+            return bExecuted;
         }
 
         /// <summary>
         /// Route using a given router and execute an algorithm on each element Chunks in the array.
+        /// Element Chunks are bound from the route the router cached for the array's ChunkStructure.
         /// </summary>
         /// <typeparam name="TRouter"></typeparam>
         /// <param name="router"></param>
         /// <param name="algorithm"></param>
         /// <param name="chunkPtr"></param>
-        /// <returns></returns>
+        /// <returns>False if the array did not fulfill the algorithm requirements or an element Chunk was skipped, see ExecuteElement.</returns>
         template<typename TRouter>
         static bool TryRun(const TRouter& router, Algorithm_t& algorithm, ChunkArrayPointer_t& chunkPtr)
         {
@@ -62,16 +69,83 @@ namespace PNC
             assert_pnc(!chunkArray.IsNull());
             if (!router.RouteAlgorithm(algorithm, chunkPtr))
                 return false;
-
+            const auto* route = router.FindRoute(&chunkArray.GetChunkStructure());
+            assert_pnc(route != nullptr);
+            bool bExecuted = true;
             for (Size_t i = 0; i < chunkArray.GetChunkCount(); ++i)
-            {
-                auto& chunk = chunkArray[i];
-                auto nodeCount = chunk.GetNodeCount();
-                algorithm.Execute(nodeCount);
-                bool nextOk = algorithm.Requirements(Routing::OffsetAlgorithmNode<ChunkArrayPointer_t>(nodeCount));
-                assert_pnc(nextOk);
-            }
-            return true;
+                bExecuted &= ExecuteElement(algorithm, chunkArray, *route, i);
+            return bExecuted;
+        }
+
+        /// <summary>
+        /// Route an algorithm on the array and execute copies of it on the element Chunks from worker threads.
+        /// Element Chunks are split in batches of grainSize Chunks. Each worker owns a copy of the routed algorithm
+        /// and keeps taking the next batch until none is left, so uneven Chunks balance over the workers.
+        /// The algorithm's Execute must only write to the Nodes and Chunk Components of the Chunk it is bound to.
+        /// </summary>
+        /// <param name="algorithm">Algorithm to route, copied once per worker. Left bound to the array.</param>
+        /// <param name="chunkPtr"></param>
+        /// <param name="grainSize">Number of consecutive element Chunks a worker processes at once.</param>
+        /// <param name="outWorkerAlgorithms">Optional vector receiving the algorithm copy of each worker, to reduce per worker results.</param>
+        /// <returns>False if the array did not fulfill the algorithm requirements or an element Chunk was skipped, see ExecuteElement.</returns>
+        static bool TryRunParallel(Algorithm_t& algorithm, ChunkArrayPointer_t& chunkPtr, Size_t grainSize = 1, std::vector<Algorithm_t>* outWorkerAlgorithms = nullptr)
+        {
+            auto& chunkArray = *chunkPtr;
+            if (chunkArray.IsNull())
+                return false;
+            Route_t route;
+            if (!RouteArray(algorithm, chunkPtr, route))
+                return false;
+            assert_pnc(grainSize > 0);
+            Size_t chunkCount = chunkArray.GetChunkCount();
+            Size_t batchCount = (chunkCount + grainSize - 1) / grainSize;
+            Size_t workerCount = FMath::Min(batchCount, (Size_t)FTaskGraphInterface::Get().GetNumWorkerThreads() + 1);
+            std::vector<Algorithm_t> localWorkerAlgorithms;
+            std::vector<Algorithm_t>& workerAlgorithms = outWorkerAlgorithms != nullptr ? *outWorkerAlgorithms : localWorkerAlgorithms;
+            workerAlgorithms.assign(workerCount, algorithm);
+            std::atomic<Size_t> nextBatch(0);
+            std::atomic<bool> bExecuted(true);
+            ParallelFor(workerCount, [&](int32 workerIndex)
+                {
+                    Algorithm_t& workerAlgorithm = workerAlgorithms[workerIndex];
+                    for (Size_t batch = nextBatch.fetch_add(1, std::memory_order_relaxed); batch < batchCount; batch = nextBatch.fetch_add(1, std::memory_order_relaxed))
+                    {
+                        Size_t end = FMath::Min(chunkCount, (batch + 1) * grainSize);
+                        for (Size_t i = batch * grainSize; i < end; ++i)
+                            if (!ExecuteElement(workerAlgorithm, chunkArray, route, i))
+                                bExecuted.store(false, std::memory_order_relaxed);
+                    }
+                });
+            return bExecuted.load(std::memory_order_relaxed);
+        }
+
+        /// <summary>
+        /// Bind an already routed algorithm to an element Chunk of the array and execute it on its Nodes.
+        /// </summary>
+        /// <param name="route">Route of the algorithm on the array, see RouteArray.</param>
+        /// <param name="chunkIndex">Index of the element Chunk in the array.</param>
+        /// <returns>False if the element Chunk was skipped because its alive Nodes are not block aligned for the algorithm's AlignedColumnT requirements.</returns>
+        template<typename TChunkArray, typename TRoute>
+        static bool ExecuteElement(Algorithm_t& algorithm, TChunkArray& chunkArray, const TRoute& route, Size_t chunkIndex)
+        {
+            using BindElement_t = Routing::BindAlgorithmChunkElement<ChunkPointerElement_t, TRoute>;
+            auto& chunk = chunkArray[chunkIndex];
+            BindElement_t bindElement(&chunk, &route, chunkIndex);
+            bool bound = algorithm.template Requirements<BindElement_t&>(bindElement);
+            assert_pnc(bound);
+            return ChunkRunner_t::ExecuteNodes(algorithm, chunk);
+        }
+
+        /// <summary>
+        /// Bind an algorithm to the array and record the component type index of each of its Component requirements.
+        /// </summary>
+        /// <returns>If the array fulfilled the algorithm requirements.</returns>
+        static bool RouteArray(Algorithm_t& algorithm, ChunkArrayPointer_t& chunkPtr, Route_t& route)
+        {
+            using RouteToCache_t = Routing::RouteAlgorithmToCacheT<ChunkArrayPointer_t, Size_t, Route_t>;
+            RouteToCache_t routeToCache(&chunkPtr, &route);
+            bool matches = algorithm.template Requirements<RouteToCache_t&>(routeToCache);
+            return matches && routeToCache.MatchForChunk;
         }
     };
 }
@@ -0,0 +1,179 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "AlgorithmRunnerKindPointerSwitch.h"
+#include "LinearChunkTree.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include <atomic>
+
+namespace PNC
+{
+    /// <summary>
+    /// Execute an algorithm on every Chunk of a tree of Chunks, each parent Chunk before its children.
+    /// Each Chunk is routed on its own with AlgorithmRunnerKindPointerSwitch, so ParentComponent requirements
+    /// are bound to the parent Chunk, which was already processed.
+    /// Chunks not fulfilling the requirements are skipped but their children are still visited.
+    /// </summary>
+    /// <typeparam name="TAlgorithm"></typeparam>
+    /// <typeparam name="TChunkStructure">Structure of the Chunk's Component data.</typeparam>
+    template<typename TAlgorithm, typename TChunkStructure>
+    struct AlgorithmRunnerChunkTree
+    {
+    public:
+        using Self_t = AlgorithmRunnerChunkTree<TAlgorithm, TChunkStructure>;
+        using Algorithm_t = TAlgorithm;
+        using ChunkStructure_t = TChunkStructure;
+        using Size_t = typename ChunkStructure_t::Size_t;
+        using KTreePointer_t = KTreePointerT<ChunkStructure_t>;
+        using LinearChunkTree_t = LinearChunkTreeT<ChunkStructure_t>;
+        using Entry_t = typename LinearChunkTree_t::Entry;
+        using ChunkRunner_t = AlgorithmRunnerKindPointerSwitch<ChunkStructure_t, Algorithm_t>;
+
+        /// <summary>
+        /// Default weight, in Nodes, under which a subtree is processed by a single worker in TryRunParallel.
+        /// </summary>
+        static constexpr Size_t DefaultGrainWeight = 16 * 1024;
+
+    public:
+        /// <summary>
+        /// Execute an algorithm on every Chunk of the subtree of a KTreePointer in depth-first order.
+        /// </summary>
+        /// <param name="algorithm"></param>
+        /// <param name="root">Root of the subtree to process.</param>
+        /// <returns>If any Chunk fulfilled the algorithm requirements.</returns>
+        static bool TryRun(Algorithm_t& algorithm, KTreePointer_t& root)
+        {
+            bool ran = ChunkRunner_t::TryRun(algorithm, root);
+            KTreePointer_t* firstChild = root.GetFirstChildChunk();
+            if (firstChild == nullptr)
+                return ran;
+            KTreePointer_t* child = firstChild;
+            do
+            {
+                ran |= TryRun(algorithm, *child);
+                child = child->GetNextSiblingChunk();
+            } while (child != firstChild);
+            return ran;
+        }
+
+        /// <summary>
+        /// Execute an algorithm on every Chunk of a LinearChunkTree, walking its array in order.
+        /// </summary>
+        /// <param name="algorithm"></param>
+        /// <param name="tree">Up to date LinearChunkTree.</param>
+        /// <returns>If any Chunk fulfilled the algorithm requirements.</returns>
+        static bool TryRun(Algorithm_t& algorithm, const LinearChunkTree_t& tree)
+        {
+            assert_pnc(!tree.IsDirty());
+            return ExecuteEntries(algorithm, tree.begin(), 0, tree.GetSize());
+        }
+
+        /// <summary>
+        /// Execute an algorithm on every Chunk of the subtree of a KTreePointer, running independent subtrees from worker threads.
+        /// See TryRunParallel on a LinearChunkTree.
+        /// </summary>
+        /// <param name="algorithm">Algorithm executed on the Chunks of heavy subtrees' roots, copied once per worker.</param>
+        /// <param name="root">Root of the subtree to process.</param>
+        /// <param name="grainWeight">Weight, in Nodes, under which a subtree is processed by a single worker.</param>
+        /// <param name="outWorkerAlgorithms">Optional vector receiving the algorithm copy of each worker, to reduce per worker results.</param>
+        /// <returns>If any Chunk fulfilled the algorithm requirements.</returns>
+        static bool TryRunParallel(Algorithm_t& algorithm, KTreePointer_t& root, Size_t grainWeight = DefaultGrainWeight, std::vector<Algorithm_t>* outWorkerAlgorithms = nullptr)
+        {
+            std::vector<Entry_t> entries;
+            LinearChunkTree_t::Linearize(&root, -1, 0, entries);
+            return ExecuteEntriesParallel(algorithm, entries.data(), (Size_t)entries.size(), grainWeight, outWorkerAlgorithms);
+        }
+
+        /// <summary>
+        /// Execute an algorithm on every Chunk of a LinearChunkTree, running independent subtrees from worker threads.
+        /// A subtree weighs the Nodes of its Chunks plus one per Chunk. Subtrees weighing at most grainWeight are tasks
+        /// processed in depth-first order by a single worker, the heaviest first. The Chunks above them are processed first
+        /// on the calling thread, so every parent Chunk is processed before its children.
+        /// The algorithm's Execute must only write to the Chunk it is bound to.
+        /// </summary>
+        /// <param name="algorithm">Algorithm executed on the Chunks above the tasks, copied once per worker.</param>
+        /// <param name="tree">Up to date LinearChunkTree.</param>
+        /// <param name="grainWeight">Weight, in Nodes, under which a subtree is processed by a single worker.</param>
+        /// <param name="outWorkerAlgorithms">Optional vector receiving the algorithm copy of each worker, to reduce per worker results.</param>
+        /// <returns>If any Chunk fulfilled the algorithm requirements.</returns>
+        static bool TryRunParallel(Algorithm_t& algorithm, const LinearChunkTree_t& tree, Size_t grainWeight = DefaultGrainWeight, std::vector<Algorithm_t>* outWorkerAlgorithms = nullptr)
+        {
+            assert_pnc(!tree.IsDirty());
+            return ExecuteEntriesParallel(algorithm, tree.begin(), tree.GetSize(), grainWeight, outWorkerAlgorithms);
+        }
+
+    protected:
+        /// <summary>
+        /// Execute an algorithm on a range of linearized entries in order.
+        /// </summary>
+        static bool ExecuteEntries(Algorithm_t& algorithm, const Entry_t* entries, Size_t begin, Size_t end)
+        {
+            bool ran = false;
+            for (Size_t i = begin; i < end; ++i)
+                ran |= ChunkRunner_t::TryRun(algorithm, *entries[i].Chunk);
+            return ran;
+        }
+
+        static bool ExecuteEntriesParallel(Algorithm_t& algorithm, const Entry_t* entries, Size_t entryCount, Size_t grainWeight, std::vector<Algorithm_t>* outWorkerAlgorithms)
+        {
+            assert_pnc(grainWeight > 0);
+            // Subtree weights from a prefix sum over the depth-first order.
+            std::vector<int64> prefixWeights(entryCount + 1);
+            prefixWeights[0] = 0;
+            for (Size_t i = 0; i < entryCount; ++i)
+                prefixWeights[i + 1] = prefixWeights[i] + 1 + entries[i].Chunk->GetChunk().GetNodeCount();
+
+            // Copies are made before the heavy Chunks are processed, each worker routes its copy per Chunk anyway.
+            std::vector<Algorithm_t> localWorkerAlgorithms;
+            std::vector<Algorithm_t>& workerAlgorithms = outWorkerAlgorithms != nullptr ? *outWorkerAlgorithms : localWorkerAlgorithms;
+            Algorithm_t pristine = algorithm;
+
+            // Process the Chunks of heavy subtrees in depth-first order and collect the light subtrees below them as tasks.
+            struct Task
+            {
+                Size_t Begin;
+                Size_t End;
+                int64 Weight;
+            };
+            std::vector<Task> tasks;
+            bool ran = false;
+            for (Size_t i = 0; i < entryCount;)
+            {
+                Size_t subtreeEnd = entries[i].SubtreeEnd;
+                int64 weight = prefixWeights[subtreeEnd] - prefixWeights[i];
+                if (weight <= grainWeight)
+                {
+                    tasks.push_back(Task{ i, subtreeEnd, weight });
+                    i = subtreeEnd;
+                }
+                else
+                {
+                    ran |= ChunkRunner_t::TryRun(algorithm, *entries[i].Chunk);
+                    ++i;
+                }
+            }
+
+            Size_t taskCount = (Size_t)tasks.size();
+            Size_t workerCount = FMath::Min(taskCount, (Size_t)FTaskGraphInterface::Get().GetNumWorkerThreads() + 1);
+            workerAlgorithms.assign(workerCount, pristine);
+            if (workerCount == 0)
+                return ran;
+            std::sort(tasks.begin(), tasks.end(), [](const Task& a, const Task& b) { return a.Weight > b.Weight; });
+            std::atomic<Size_t> nextTask(0);
+            std::atomic<bool> anyRan(ran);
+            ParallelFor(workerCount, [&](int32 workerIndex)
+                {
+                    Algorithm_t& workerAlgorithm = workerAlgorithms[workerIndex];
+                    bool workerRan = false;
+                    for (Size_t task = nextTask.fetch_add(1, std::memory_order_relaxed); task < taskCount; task = nextTask.fetch_add(1, std::memory_order_relaxed))
+                        workerRan |= ExecuteEntries(workerAlgorithm, entries, tasks[task].Begin, tasks[task].End);
+                    if (workerRan)
+                        anyRan.store(true, std::memory_order_relaxed);
+                });
+            return anyRan.load(std::memory_order_relaxed);
+        }
+    };
+}
@@ -0,0 +1,75 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include <memory>
+
+namespace PNC
+{
+    /// <summary>
+    /// Typed handle to a Node Component column guaranteed to start on a TAlignment boundary and to be padded
+    /// up to a whole number of TAlignment blocks past the Chunk's Node count.
+    /// Use it instead of a raw pointer in an algorithm's Requirements so the compiler can emit aligned full-width vector loops.
+    /// Algorithms requiring an AlignedColumnT only run on Chunks whose ChunkStructure was created with a column alignment
+    /// of at least TAlignment, see ChunkStructureT::SimdColumnAlignment.
+    /// Runners executing an algorithm on ranges of a Chunk, between dead Nodes of NodeRemovalMode_Stable or on a NodeSelection,
+    /// only split the Chunk on multiples of NodeMultiple Nodes, so every range starts aligned and padding a range never reaches
+    /// another range's Nodes. When a range would not be block aligned the algorithm is not executed and the runner returns false,
+    /// unless the algorithm declares Execute(Size_t nodeCount, const NodeSelectionT<Size_t>& selection) to mask the Nodes itself.
+    /// ChunkHierarchyT levels are never block aligned and reject such algorithms.
+    /// ex.:
+    ///     AlignedColumnT<const Velocity> Velocities;
+    ///     AlignedColumnT<Position> Positions;
+    ///     template<typename TReq> bool Requirements(TReq req) { return req.Component(Velocities) && req.Component(Positions); }
+    ///     void Execute(Size_t nodeCount)
+    ///     {
+    ///         for (Size_t i = 0; i < Positions.PadNodeCount(nodeCount); ++i)
+    ///             Positions[i].Value += Velocities[i].Value;
+    ///     }
+    /// </summary>
+    /// <typeparam name="TComponent">A NodeComponent, may be const.</typeparam>
+    /// <typeparam name="TAlignment">Alignment in bytes, a power of two.</typeparam>
+    template<typename TComponent, SIZE_T TAlignment = 64>
+    struct AlignedColumnT
+    {
+    public:
+        using Self_t = AlignedColumnT<TComponent, TAlignment>;
+        using Component_t = TComponent;
+        static constexpr SIZE_T Alignment = TAlignment;
+
+        /// <summary>
+        /// Largest power of two dividing the Component size.
+        /// </summary>
+        static constexpr SIZE_T SizeAlignment = sizeof(TComponent) & (0 - sizeof(TComponent));
+
+        /// <summary>
+        /// Smallest number of Nodes spanning a whole number of aligned blocks.
+        /// </summary>
+        static constexpr SIZE_T NodeMultiple = TAlignment / (SizeAlignment < TAlignment ? SizeAlignment : TAlignment);
+
+        static_assert((TAlignment & (TAlignment - 1)) == 0, "AlignedColumnT alignment must be a power of two.");
+        static_assert(TComponent::Owner == ComponentOwner_Node, "AlignedColumnT only supports Node Components.");
+
+    public:
+        /// <summary>
+        /// First Component of the column. Set by the AlgorithmRequirementFulfiller.
+        /// </summary>
+        TComponent* Data = nullptr;
+
+    public:
+        /// <summary>
+        /// Get the first Component of the column with the alignment guarantee visible to the compiler.
+        /// </summary>
+        FORCEINLINE TComponent* Get()const { return std::assume_aligned<TAlignment>(Data); }
+
+        FORCEINLINE TComponent& operator[](SIZE_T index)const { return Get()[index]; }
+
+        /// <summary>
+        /// Round a Node count up to the end of its last aligned block.
+        /// Components between the Node count and the padded count are valid memory with unspecified values.
+        /// </summary>
+        template<typename TSize>
+        static constexpr TSize PadNodeCount(TSize nodeCount) { return (TSize)Align((SIZE_T)nodeCount, NodeMultiple); }
+    };
+}
@@ -3,6 +3,8 @@
 
 #pragma once
 #include "common.h"
+#include "ChunkAllocator.h"
+#include "NodeOccupancy.h"
 
 namespace PNC
 {
@@ -10,15 +12,18 @@ namespace PNC
     /// Decorator struct that adds allocation of Chunk's Component data
     /// </summary>
     /// <typeparam name="TBase"></typeparam>
-    template<typename TBase>
+    /// <typeparam name="TAllocator">Allocator policy used for the Chunk's memory block. See ChunkHeapAllocator.</typeparam>
+    template<typename TBase, typename TAllocator = ChunkHeapAllocator>
     struct ChunkAllocationT : public TBase
     {
     public:
         using Base_t = TBase;
         using ChunkStructure_t = typename TBase::ChunkStructure_t;
         using Size_t = typename TBase::Size_t;
-        using Self_t = ChunkAllocationT<TBase>;
+        using Self_t = ChunkAllocationT<TBase, TAllocator>;
         using Internal_t = ChunkPointerInternalT<ChunkStructure_t>;
+        using Allocator_t = TAllocator;
+        using NodeOccupancy_t = NodeOccupancyT<Size_t>;
 
     private:
         /// <summary>
@@ -26,6 +31,26 @@ namespace PNC
         /// </summary>
         Size_t NodeCapacity;
 
+        /// <summary>
+        /// Allocator policy the Chunk's memory block comes from.
+        /// </summary>
+        UE_NO_UNIQUE_ADDRESS Allocator_t Allocator;
+
+        /// <summary>
+        /// What happens to the other Nodes when a Node is removed with RemoveNode.
+        /// </summary>
+        NodeRemovalMode RemovalMode;
+
+        /// <summary>
+        /// Alive Nodes and free slots when RemovalMode is NodeRemovalMode_Stable.
+        /// </summary>
+        NodeOccupancy_t Occupancy;
+
+        /// <summary>
+        /// Node count this Chunk was last counted with in its ChunkStructure's stats.
+        /// </summary>
+        Size_t StatsNodeCount;
+
     public:
         /// <summary>
         /// Get the maximum number of Nodes the Chunk can grow to.
@@ -47,6 +72,9 @@ namespace PNC
         ChunkAllocationT()
             : Base_t()
             , NodeCapacity(0)
+            , Allocator()
+            , RemovalMode(NodeRemovalMode_SwapAndPop)
+            , StatsNodeCount(0)
         {
         }
 
@@ -58,10 +86,14 @@ namespace PNC
         ChunkAllocationT(const Self_t& o)
             : Base_t(o)
             , NodeCapacity(o.NodeCapacity)
+            , Allocator(o.Allocator)
+            , RemovalMode(o.RemovalMode)
+            , Occupancy(o.Occupancy)
+            , StatsNodeCount(0)
         {
+            BindOccupancy();
             if (o.IsNull())
                 return;
-            AllocateComponentDataArray();
             AllocateDataCopy(o);
         }
 
@@ -76,30 +108,74 @@ namespace PNC
             if (this == &o)
                 return *this;
             DeallocateData();
-            DeallocateComponentDataArray();
             Base_t::operator=(o);
             NodeCapacity = o.NodeCapacity;
+            RemovalMode = o.RemovalMode;
+            Occupancy = o.Occupancy;
+            BindOccupancy();
             if (o.IsNull())
                 return *this;
-            AllocateComponentDataArray();
             AllocateDataCopy(o);
             return *this;
         }
 
+        /// <summary>
+        /// Take ownership of another Chunk's Component data without copying it.
+        /// The other Chunk becomes a Null Chunk.
+        /// </summary>
+        /// <param name="o"></param>
+        ChunkAllocationT(Self_t&& o)
+            : Base_t(o)
+            , NodeCapacity(o.NodeCapacity)
+            , Allocator(MoveTemp(o.Allocator))
+            , RemovalMode(o.RemovalMode)
+            , Occupancy(MoveTemp(o.Occupancy))
+            , StatsNodeCount(o.StatsNodeCount)
+        {
+            BindOccupancy();
+            o.ReleaseData();
+        }
+
+        /// <summary>
+        /// Deallocate any previous data and take ownership of another Chunk's Component data without copying it.
+        /// The other Chunk becomes a Null Chunk.
+        /// </summary>
+        /// <param name="o"></param>
+        Self_t& operator=(Self_t&& o)
+        {
+            if (this == &o)
+                return *this;
+            DeallocateData();
+            Base_t::operator=(o);
+            NodeCapacity = o.NodeCapacity;
+            Allocator = MoveTemp(o.Allocator);
+            RemovalMode = o.RemovalMode;
+            Occupancy = MoveTemp(o.Occupancy);
+            StatsNodeCount = o.StatsNodeCount;
+            BindOccupancy();
+            o.ReleaseData();
+            return *this;
+        }
+
         /// <summary>
         /// Create a Chunk of a given ChunkStructure and allocate the Component's memory
         /// The Components' memory can fit as many instances of each Components as the Chunk's capacity.
+        /// The Component data pointers and all Component columns are allocated as a single block laid out by the ChunkStructure's ChunkLayout.
         /// Any computation performed on this Chunk will only process node within the chunk's Node count and not it's capacity.
         /// </summary>
         /// <param name="chunkStructure">Structure of the Chunk's component data.</param>
-        /// <param name="nodeCapacity">Maximum number of Nodes this Chunk can grow to.</param>
+        /// <param name="nodeCapacity">Maximum number of Nodes this Chunk can grow to, rounded up to the structure's NodeCapacityMultiple.</param>
         /// <param name="nodeCount"></param>
-        ChunkAllocationT(const ChunkStructure_t* chunkStructure, Size_t nodeCapacity, Size_t nodeCount = 0)
+        /// <param name="allocator">Allocator policy instance the memory block comes from.</param>
+        ChunkAllocationT(const ChunkStructure_t* chunkStructure, Size_t nodeCapacity, Size_t nodeCount = 0, const Allocator_t& allocator = Allocator_t())
             : Base_t(chunkStructure, nodeCount)
-            , NodeCapacity(nodeCapacity)
+            , NodeCapacity(chunkStructure->GetLayout().PadNodeCapacity(nodeCapacity))
+            , Allocator(allocator)
+            , RemovalMode(NodeRemovalMode_SwapAndPop)
+            , StatsNodeCount(0)
         {
-            AllocateComponentDataArray();
             AllocateData();
+            ConstructComponents(0, nodeCount, true);
         }
 
         /// <summary>
@@ -108,72 +184,362 @@ namespace PNC
         ~ChunkAllocationT()
         {
             DeallocateData();
-            DeallocateComponentDataArray();
+        }
+
+    public:
+        /// <summary>
+        /// Grow the Chunk's capacity to at least the given number of Nodes.
+        /// Does nothing if the capacity is already large enough.
+        /// </summary>
+        /// <param name="nodeCapacity">Minimum number of Nodes the Chunk must be able to hold.</param>
+        void Reserve(Size_t nodeCapacity)
+        {
+            if (nodeCapacity <= NodeCapacity)
+                return;
+            Reallocate(nodeCapacity);
+        }
+
+        /// <summary>
+        /// Append Nodes at the end of the Chunk, growing the capacity geometrically if required.
+        /// Trivial Components of the new Nodes are uninitialized, other Components are default constructed.
+        /// </summary>
+        /// <param name="count">Number of Nodes to add.</param>
+        /// <returns>Index of the first added Node.</returns>
+        Size_t AddNodes(Size_t count)
+        {
+            auto& chunk = GetInternalChunk();
+            assert_pnc(!chunk.IsNull());
+            assert_pnc(count >= 0);
+            Size_t first = chunk.NodeCount;
+            Size_t required = first + count;
+            if (required > NodeCapacity)
+                Reallocate(FMath::Max(required, FMath::Max(NodeCapacity * 2, MinGrowCapacity)));
+            chunk.NodeCount = required;
+            ConstructComponents(first, count, false);
+            if (RemovalMode == NodeRemovalMode_Stable)
+                Occupancy.SetAlive(first, required);
+            UpdateStats();
+            return first;
+        }
+
+        /// <summary>
+        /// Reduce the Chunk's capacity to its Node count.
+        /// </summary>
+        void ShrinkToFit()
+        {
+            auto& chunk = GetInternalChunk();
+            if (chunk.IsNull() || chunk.Structure->GetLayout().PadNodeCapacity(chunk.NodeCount) == NodeCapacity)
+                return;
+            Reallocate(chunk.NodeCount);
+        }
+
+        /// <summary>
+        /// Get what happens to the other Nodes when a Node is removed with RemoveNode.
+        /// </summary>
+        NodeRemovalMode GetNodeRemovalMode()const { return RemovalMode; }
+
+        /// <summary>
+        /// Change what happens to the other Nodes when a Node is removed with RemoveNode.
+        /// Switching away from NodeRemovalMode_Stable compacts the Chunk first.
+        /// </summary>
+        /// <param name="mode"></param>
+        /// <param name="compactionThreshold">Fraction of dead Nodes above which CompactIfFragmented compacts the Chunk.</param>
+        void SetNodeRemovalMode(NodeRemovalMode mode, float compactionThreshold = 0.25f)
+        {
+            if (RemovalMode == NodeRemovalMode_Stable && mode != NodeRemovalMode_Stable)
+                Compact();
+            RemovalMode = mode;
+            Occupancy.CompactionThreshold = compactionThreshold;
+            if (mode == NodeRemovalMode_Stable)
+                Occupancy.Reset(NodeCapacity, GetInternalChunk().NodeCount);
+            else
+                Occupancy = NodeOccupancy_t();
+            BindOccupancy();
+        }
+
+        /// <summary>
+        /// Add a single Node. With NodeRemovalMode_Stable the slot of the last removed Node is reused first.
+        /// Trivial Components of the new Node are uninitialized, other Components are default constructed.
+        /// </summary>
+        /// <returns>Index of the added Node.</returns>
+        Size_t AddNode()
+        {
+            if (RemovalMode == NodeRemovalMode_Stable)
+            {
+                Size_t nodeIndex = Occupancy.ReviveFreeSlot();
+                if (nodeIndex >= 0)
+                    return nodeIndex;
+            }
+            return AddNodes(1);
+        }
+
+        /// <summary>
+        /// Remove a single Node according to the Chunk's NodeRemovalMode.
+        /// With NodeRemovalMode_SwapAndPop the last Node moves into the removed slot.
+        /// With NodeRemovalMode_Stable the Node is only marked dead in O(1) and algorithms skip it.
+        /// </summary>
+        /// <param name="nodeIndex">Index of an alive Node.</param>
+        void RemoveNode(Size_t nodeIndex)
+        {
+            auto& chunk = GetInternalChunk();
+            assert_pnc(nodeIndex >= 0 && nodeIndex < chunk.NodeCount);
+            if (RemovalMode == NodeRemovalMode_Stable)
+            {
+                // Dead Nodes hold default constructed Components so whole ranges can always be copied and destroyed.
+                Occupancy.Kill(nodeIndex);
+                DestroyComponents(nodeIndex, 1, false);
+                ConstructComponents(nodeIndex, 1, false);
+            }
+            else
+                RemoveNodes(&nodeIndex, 1);
+        }
+
+        /// <summary>
+        /// Remove a batch of Nodes by moving the last Nodes into their slots. See ChunkPointerT::RemoveNodes.
+        /// </summary>
+        Size_t RemoveNodes(const Size_t* nodeIndices, Size_t count, Size_t* remap = nullptr)
+        {
+            Size_t nodeCount = Base_t::RemoveNodes(nodeIndices, count, remap);
+            UpdateStats();
+            return nodeCount;
+        }
+
+        /// <summary>
+        /// Remove the Nodes whose bit is set in a bitmask by moving the last Nodes into their slots. See ChunkPointerT::RemoveNodesMasked.
+        /// </summary>
+        Size_t RemoveNodesMasked(const uint64* mask, Size_t* remap = nullptr)
+        {
+            Size_t nodeCount = Base_t::RemoveNodesMasked(mask, remap);
+            UpdateStats();
+            return nodeCount;
+        }
+
+        /// <summary>
+        /// Test if a Node is alive. Always true below the Node count unless using NodeRemovalMode_Stable.
+        /// </summary>
+        bool IsNodeAlive(Size_t nodeIndex)const
+        {
+            return RemovalMode != NodeRemovalMode_Stable || Occupancy.IsAlive(nodeIndex);
+        }
+
+        /// <summary>
+        /// Number of dead Nodes below the Node count when using NodeRemovalMode_Stable.
+        /// </summary>
+        Size_t GetDeadNodeCount()const { return Occupancy.GetDeadCount(); }
+
+        /// <summary>
+        /// Compact the Chunk if the fraction of dead Nodes is above the compaction threshold.
+        /// Call at a point where Node indices are allowed to change, such as the end of a frame.
+        /// </summary>
+        /// <param name="remap">Optional array of at least GetNodeCount() elements receiving the new index of each Node or -1 if dead.</param>
+        /// <returns>If the Chunk was compacted.</returns>
+        bool CompactIfFragmented(Size_t* remap = nullptr)
+        {
+            if (RemovalMode != NodeRemovalMode_Stable || !Occupancy.IsFragmented(GetInternalChunk().NodeCount))
+                return false;
+            Compact(remap);
+            return true;
+        }
+
+        /// <summary>
+        /// Remove all dead Nodes by moving the last alive Nodes into their slots. See ChunkPointerT::RemoveNodes.
+        /// </summary>
+        /// <param name="remap">Optional array of at least GetNodeCount() elements receiving the new index of each Node or -1 if dead.</param>
+        void Compact(Size_t* remap = nullptr)
+        {
+            auto& chunk = GetInternalChunk();
+            if (RemovalMode != NodeRemovalMode_Stable || chunk.IsNull())
+                return;
+            std::vector<uint64> deadMask;
+            Occupancy.GetDeadMask(chunk.NodeCount, deadMask);
+            RemoveNodesMasked(deadMask.data(), remap);
+            Occupancy.Reset(NodeCapacity, chunk.NodeCount);
+            BindOccupancy();
+        }
+
+        /// <summary>
+        /// Update the occupancy of this Chunk in its ChunkStructure's stats.
+        /// Called by every ChunkAllocationT method changing the Node count,
+        /// call it after changing the Node count through a ChunkPointer to this Chunk.
+        /// </summary>
+        void UpdateStats()
+        {
+            auto& chunk = GetInternalChunk();
+            if (chunk.IsNull())
+                return;
+            chunk.Structure->GetStats().UpdateOccupancy(StatsNodeCount, NodeCapacity, chunk.NodeCount, NodeCapacity);
+            StatsNodeCount = chunk.NodeCount;
         }
 
     protected:
+        /// <summary>
+        /// Smallest capacity AddNodes grows an empty Chunk to.
+        /// </summary>
+        static constexpr Size_t MinGrowCapacity = 16;
+
         Internal_t& GetInternalChunk() { return (Internal_t&)this->GetChunk(); }
 
+        const Internal_t& GetInternalChunk()const { return (const Internal_t&)this->GetChunk(); }
+
+        /// <summary>
+        /// Allocate a single block for the Component data pointers and all Component columns.
+        /// </summary>
         void AllocateData()
         {
             auto& chunk = GetInternalChunk();
             assert_pnc(!chunk.IsNull());
-            auto componentCount = chunk.Structure->Components.GetSize();
-            for (Size_t i = 0; i < componentCount; ++i)
+            const auto& layout = chunk.Structure->GetLayout();
+            void* block = Allocator.Allocate(chunk.Structure, NodeCapacity, layout.GetBlockSize(NodeCapacity), layout.Alignment);
+            chunk.ComponentData = layout.PlaceColumns(block, NodeCapacity);
+            auto& stats = chunk.Structure->GetStats();
+            stats.AddBytes(layout.GetBlockSize(NodeCapacity));
+            stats.AddChunk(chunk.NodeCount, NodeCapacity);
+            StatsNodeCount = chunk.NodeCount;
+        }
+
+        /// <summary>
+        /// Allocate a single block with the same capacity as another Chunk and copy all its Component data in one operation.
+        /// </summary>
+        /// <param name="o"></param>
+        void AllocateDataCopy(const Self_t& o)
+        {
+            auto& chunk = GetInternalChunk();
+            const auto& other = o.GetInternalChunk();
+            assert_pnc(!chunk.IsNull());
+            assert_pnc(chunk.Structure == other.Structure);
+            assert_pnc(NodeCapacity == o.NodeCapacity);
+            AllocateData();
+            const auto& layout = chunk.Structure->GetLayout();
+            if (layout.bTrivial)
             {
-                auto componentTypeInfo = chunk.Structure->Components[i];
-                chunk.ComponentData[i] = componentTypeInfo->Allocate(NodeCapacity);
+                FMemory::Memcpy((uint8*)chunk.ComponentData + layout.DataOffset, (const uint8*)other.ComponentData + layout.DataOffset, layout.GetDataSize(NodeCapacity));
+                return;
+            }
+            for (const auto& column : layout.Columns)
+            {
+                auto componentTypeInfo = chunk.Structure->Components[column.ComponentIndex];
+                componentTypeInfo->Copy(chunk.ComponentData[column.ComponentIndex], other.ComponentData[column.ComponentIndex], other.NodeCount);
             }
         }
 
-        void AllocateDataCopy(const Self_t& o)
+        /// <summary>
+        /// Move the Component data to a new block of a different capacity.
+        /// Each column is copied once, in the order they are laid out in memory.
+        /// Nodes beyond the new capacity are discarded.
+        /// </summary>
+        /// <param name="nodeCapacity">Capacity of the new block.</param>
+        void Reallocate(Size_t nodeCapacity)
         {
             auto& chunk = GetInternalChunk();
             assert_pnc(!chunk.IsNull());
-            assert_pnc(chunk.IsSameChunkStructure(chunk, o.GetChunk()));
+            assert_pnc(nodeCapacity >= 0);
+            const auto& layout = chunk.Structure->GetLayout();
+            nodeCapacity = layout.PadNodeCapacity(nodeCapacity);
+            void** oldComponentData = chunk.ComponentData;
+            Size_t oldCapacity = NodeCapacity;
+            Size_t nodeCount = FMath::Min(chunk.NodeCount, nodeCapacity);
+            if (nodeCount < chunk.NodeCount)
+                DestroyComponents(nodeCount, chunk.NodeCount - nodeCount, false);
+
+            void* block = Allocator.Allocate(chunk.Structure, nodeCapacity, layout.GetBlockSize(nodeCapacity), layout.Alignment);
+            void** componentData = layout.PlaceColumns(block, nodeCapacity);
+            for (const auto& column : layout.Columns)
+            {
+                auto componentTypeInfo = chunk.Structure->Components[column.ComponentIndex];
+                componentTypeInfo->Relocate(componentData[column.ComponentIndex], oldComponentData[column.ComponentIndex], nodeCount);
+            }
+            Allocator.Deallocate(chunk.Structure, oldCapacity, oldComponentData, layout.GetBlockSize(oldCapacity), layout.Alignment);
+            auto& stats = chunk.Structure->GetStats();
+            stats.AddBytes(layout.GetBlockSize(nodeCapacity));
+            stats.RemoveBytes(layout.GetBlockSize(oldCapacity));
+            stats.UpdateOccupancy(StatsNodeCount, oldCapacity, nodeCount, nodeCapacity);
+            StatsNodeCount = nodeCount;
+
+            chunk.ComponentData = componentData;
+            chunk.NodeCount = nodeCount;
+            NodeCapacity = nodeCapacity;
+            if (RemovalMode == NodeRemovalMode_Stable)
+            {
+                Occupancy.Reserve(nodeCapacity);
+                BindOccupancy();
+            }
+        }
+
+        /// <summary>
+        /// Default construct the Components of a range of Nodes and optionally the Chunk Components.
+        /// </summary>
+        void ConstructComponents(Size_t nodeIndex, Size_t count, bool bChunkComponents)
+        {
+            auto& chunk = GetInternalChunk();
+            if (chunk.Structure->GetLayout().bTrivial)
+                return;
             auto componentCount = chunk.Structure->Components.GetSize();
             for (Size_t i = 0; i < componentCount; ++i)
             {
                 auto componentTypeInfo = chunk.Structure->Components[i];
-                chunk.ComponentData[i] = componentTypeInfo->AllocateCopy(o.ComponentData[i], o.NodeCapacity, o.NodeCount);
+                componentTypeInfo->ConstructNodes(chunk.ComponentData[i], nodeIndex, count);
+                if (bChunkComponents)
+                    componentTypeInfo->ConstructChunk(chunk.ComponentData[i]);
             }
         }
 
-        void DeallocateData()
+        /// <summary>
+        /// Destroy the Components of a range of Nodes and optionally the Chunk Components.
+        /// </summary>
+        void DestroyComponents(Size_t nodeIndex, Size_t count, bool bChunkComponents)
         {
             auto& chunk = GetInternalChunk();
-            if (chunk.Structure == nullptr)
+            if (chunk.Structure->GetLayout().bTrivial)
                 return;
             auto componentCount = chunk.Structure->Components.GetSize();
             for (Size_t i = 0; i < componentCount; ++i)
             {
                 auto componentTypeInfo = chunk.Structure->Components[i];
-                componentTypeInfo->Deallocate(chunk.ComponentData[i], NodeCapacity);
+                componentTypeInfo->DestroyNodes(chunk.ComponentData[i], nodeIndex, count);
+                if (bChunkComponents)
+                    componentTypeInfo->DestroyChunk(chunk.ComponentData[i]);
             }
         }
 
-        void AllocateComponentDataArray()
+        /// <summary>
+        /// Point the Chunk to its occupancy bitmap when using NodeRemovalMode_Stable.
+        /// </summary>
+        void BindOccupancy()
         {
-            auto& chunk = GetInternalChunk();
-            chunk.ComponentData = (void**)FMemory::Malloc(chunk.Structure->Components.GetSize() * sizeof(void*), alignof(void*));
+            GetInternalChunk().Occupancy = RemovalMode == NodeRemovalMode_Stable ? Occupancy.GetBits() : nullptr;
         }
 
-        void DeallocateComponentDataArray()
+        /// <summary>
+        /// Forget the Chunk's block without freeing it, after its ownership was moved to another Chunk.
+        /// </summary>
+        void ReleaseData()
         {
             auto& chunk = GetInternalChunk();
-            if (chunk.Structure == nullptr)
-                return;
-            FMemory::Free(chunk.ComponentData);
+            chunk.Structure = nullptr;
+            chunk.ComponentData = nullptr;
+            chunk.NodeCount = 0;
+            chunk.Occupancy = nullptr;
+            NodeCapacity = 0;
+            StatsNodeCount = 0;
+            RemovalMode = NodeRemovalMode_SwapAndPop;
+            Occupancy = NodeOccupancy_t();
         }
 
-        void CopyComponentDataArray(void** componentData)const
+        /// <summary>
+        /// Free the Chunk's block. The Component data pointers array is the beginning of the block.
+        /// </summary>
+        void DeallocateData()
         {
             auto& chunk = GetInternalChunk();
-            auto componentCount = chunk.Structure->Components.GetSize();
-            for (Size_t i = 0; i < componentCount; ++i)
-            {
-                chunk.ComponentData[i] = componentData[i];
-            }
+            if (chunk.Structure == nullptr)
+                return;
+            DestroyComponents(0, chunk.NodeCount, true);
+            const auto& layout = chunk.Structure->GetLayout();
+            Allocator.Deallocate(chunk.Structure, NodeCapacity, chunk.ComponentData, layout.GetBlockSize(NodeCapacity), layout.Alignment);
+            chunk.ComponentData = nullptr;
+            auto& stats = chunk.Structure->GetStats();
+            stats.RemoveBytes(layout.GetBlockSize(NodeCapacity));
+            stats.RemoveChunk(StatsNodeCount, NodeCapacity);
         }
     };
 }
@@ -0,0 +1,44 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+
+namespace PNC
+{
+    /// <summary>
+    /// Default allocator policy of ChunkAllocationT and ChunkArrayAllocationT.
+    /// Allocates and frees Chunk memory directly with FMemory.
+    ///
+    /// An allocator policy must provide:
+    ///     void* Allocate(const TChunkStructure* chunkStructure, SIZE_T nodeCapacity, SIZE_T size, uint32 alignment);
+    ///     void Deallocate(const TChunkStructure* chunkStructure, SIZE_T nodeCapacity, void* ptr, SIZE_T size, uint32 alignment);
+    /// Deallocate always receives the same arguments that were given to the matching Allocate.
+    /// </summary>
+    struct ChunkHeapAllocator
+    {
+    public:
+        /// <summary>
+        /// Allocate memory for a Chunk.
+        /// </summary>
+        /// <param name="chunkStructure">Structure of the Chunk the memory is for.</param>
+        /// <param name="nodeCapacity">Node capacity of the Chunk the memory is for.</param>
+        /// <param name="size">Size in bytes.</param>
+        /// <param name="alignment">Alignment in bytes.</param>
+        /// <returns>Pointer to the allocated memory. Must be freed by calling Deallocate with the same arguments.</returns>
+        template<typename TChunkStructure>
+        void* Allocate(const TChunkStructure* chunkStructure, SIZE_T nodeCapacity, SIZE_T size, uint32 alignment)
+        {
+            return FMemory::Malloc(size, alignment);
+        }
+
+        /// <summary>
+        /// Free memory previously returned by Allocate.
+        /// </summary>
+        template<typename TChunkStructure>
+        void Deallocate(const TChunkStructure* chunkStructure, SIZE_T nodeCapacity, void* ptr, SIZE_T size, uint32 alignment)
+        {
+            FMemory::Free(ptr);
+        }
+    };
+}
@@ -0,0 +1,205 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "ChunkPointer.h"
+
+namespace PNC
+{
+    /// <summary>
+    /// A bump allocator for transient Chunk memory such as intermediate per-node results.
+    /// Memory is carved sequentially from large pages and is never freed individually.
+    /// Reset() makes all the memory available again in O(1), typically at the end of a frame.
+    /// A ChunkArena is not thread-safe, use one arena per thread.
+    /// </summary>
+    struct ChunkArena
+    {
+    public:
+        using Self_t = ChunkArena;
+
+    protected:
+        struct Page
+        {
+            uint8* Data;
+            SIZE_T Size;
+        };
+
+        /// <summary>
+        /// Pages allocated so far, in the order they are used.
+        /// Pages are kept across Reset() so the next frame does not allocate.
+        /// </summary>
+        std::vector<Page> Pages;
+
+        /// <summary>
+        /// Index of the page allocations are carved from.
+        /// </summary>
+        SIZE_T CurrentPage;
+
+        /// <summary>
+        /// Offset in bytes of the next free byte in the current page.
+        /// </summary>
+        SIZE_T Cursor;
+
+        /// <summary>
+        /// Minimum size in bytes of a new page.
+        /// </summary>
+        SIZE_T PageSize;
+
+    public:
+        static constexpr SIZE_T DefaultPageSize = 256 * 1024;
+        static constexpr uint32 PageAlignment = 64;
+
+        /// <summary>
+        /// Create an empty arena. No memory is allocated until the first allocation.
+        /// </summary>
+        /// <param name="pageSize">Minimum size in bytes of each page.</param>
+        ChunkArena(SIZE_T pageSize = DefaultPageSize)
+            : CurrentPage(0)
+            , Cursor(0)
+            , PageSize(pageSize)
+        {
+        }
+
+        ChunkArena(const ChunkArena&) = delete;
+        ChunkArena& operator=(const ChunkArena&) = delete;
+
+        ~ChunkArena()
+        {
+            for (auto& page : Pages)
+                FMemory::Free(page.Data);
+        }
+
+    public:
+        /// <summary>
+        /// Carve memory from the arena. The memory remains valid until the next call to Reset().
+        /// </summary>
+        /// <param name="size">Size in bytes.</param>
+        /// <param name="alignment">Alignment in bytes.</param>
+        /// <returns>Pointer to the memory.</returns>
+        void* Allocate(SIZE_T size, uint32 alignment)
+        {
+            while (CurrentPage < Pages.size())
+            {
+                const Page& page = Pages[CurrentPage];
+                uint8* ptr = Align(page.Data + Cursor, alignment);
+                if (ptr + size <= page.Data + page.Size)
+                {
+                    Cursor = (ptr + size) - page.Data;
+                    return ptr;
+                }
+                ++CurrentPage;
+                Cursor = 0;
+            }
+            SIZE_T pageSize = FMath::Max(PageSize, size + alignment);
+            Pages.push_back(Page{ (uint8*)FMemory::Malloc(pageSize, PageAlignment), pageSize });
+            uint8* ptr = Align(Pages.back().Data, alignment);
+            Cursor = (ptr + size) - Pages.back().Data;
+            return ptr;
+        }
+
+        /// <summary>
+        /// Make all the arena's memory available again. Every pointer returned by Allocate becomes invalid.
+        /// Transient Chunks using this arena must be destroyed before calling Reset().
+        /// </summary>
+        void Reset()
+        {
+            CurrentPage = 0;
+            Cursor = 0;
+        }
+
+        /// <summary>
+        /// Free the pages that were not used since the last Reset().
+        /// </summary>
+        void Trim()
+        {
+            SIZE_T keep = Pages.empty() ? 0 : CurrentPage + 1;
+            for (SIZE_T i = keep; i < Pages.size(); ++i)
+                FMemory::Free(Pages[i].Data);
+            Pages.resize(keep);
+        }
+
+        /// <summary>
+        /// Total bytes allocated from FMemory by the arena.
+        /// </summary>
+        SIZE_T GetReservedBytes()const
+        {
+            SIZE_T bytes = 0;
+            for (auto& page : Pages)
+                bytes += page.Size;
+            return bytes;
+        }
+
+    public:
+        /// <summary>
+        /// Create a view of a Chunk with extra scratch columns allocated from the arena.
+        /// The scratch ChunkStructure must start with the same component types, in the same order, as the Chunk's ChunkStructure.
+        /// Original columns are shared with the Chunk, scratch columns are allocated for the Chunk's node count padded like the scratch structure requires.
+        /// The view is valid until the next call to Reset() and can be passed to any algorithm requiring both original and scratch components.
+        /// </summary>
+        /// <param name="chunk">Chunk to extend.</param>
+        /// <param name="scratchStructure">ChunkStructure made of the Chunk's structure followed by the scratch components.</param>
+        /// <returns>A ChunkPointer to the extended Chunk</returns>
+        template<typename TChunkStructure>
+        ChunkPointerT<TChunkStructure> AttachColumns(const ChunkPointerT<TChunkStructure>& chunk, const TChunkStructure* scratchStructure)
+        {
+            using Internal_t = ChunkPointerInternalT<TChunkStructure>;
+            using Size_t = typename TChunkStructure::Size_t;
+            const auto& source = (const Internal_t&)chunk.GetChunk();
+            assert_pnc(!source.IsNull());
+            const auto& components = source.Structure->Components;
+            const auto& scratchComponents = scratchStructure->Components;
+            auto componentCount = components.GetSize();
+            auto scratchCount = scratchComponents.GetSize();
+            assert_pnc(scratchCount >= componentCount);
+
+            void** componentData = (void**)Allocate(scratchCount * sizeof(void*), alignof(void*));
+            for (Size_t i = 0; i < componentCount; ++i)
+            {
+                assert_pnc(components[i] == scratchComponents[i]);
+                componentData[i] = source.ComponentData[i];
+            }
+            const auto& scratchLayout = scratchStructure->GetLayout();
+            Size_t nodeCapacity = scratchLayout.PadNodeCapacity(source.NodeCount);
+            for (Size_t i = componentCount; i < scratchCount; ++i)
+            {
+                const auto* componentType = scratchComponents[i];
+                componentData[i] = Allocate(componentType->GetAllocationSize(nodeCapacity), FMath::Max(componentType->Align, scratchLayout.ColumnAlignment));
+            }
+            return ChunkPointerT<TChunkStructure>(scratchStructure, source.NodeCount, componentData);
+        }
+    };
+
+    /// <summary>
+    /// Allocator policy carving Chunk memory from a ChunkArena.
+    /// Deallocation does nothing, the memory is reclaimed when the arena is Reset().
+    /// ex.: ChunkAllocationT<ChunkPointer, ChunkArenaAllocator> scratch(&structure, nodeCapacity, 0, ChunkArenaAllocator(&arena));
+    /// </summary>
+    struct ChunkArenaAllocator
+    {
+    public:
+        ChunkArena* Arena;
+
+        ChunkArenaAllocator()
+            : Arena(nullptr)
+        {
+        }
+
+        ChunkArenaAllocator(ChunkArena* arena)
+            : Arena(arena)
+        {
+        }
+
+        template<typename TChunkStructure>
+        void* Allocate(const TChunkStructure* chunkStructure, SIZE_T nodeCapacity, SIZE_T size, uint32 alignment)
+        {
+            assert_pnc(Arena != nullptr);
+            return Arena->Allocate(size, alignment);
+        }
+
+        template<typename TChunkStructure>
+        void Deallocate(const TChunkStructure* chunkStructure, SIZE_T nodeCapacity, void* ptr, SIZE_T size, uint32 alignment)
+        {
+        }
+    };
+}
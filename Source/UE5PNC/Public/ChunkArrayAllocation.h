@@ -3,6 +3,10 @@
 
 #pragma once
 #include "common.h"
+#include "ChunkAllocator.h"
+#include "NodeOccupancy.h"
+#include "ChunkVirtualMemory.h"
+#include <limits>
 
 namespace PNC
 {
@@ -10,18 +14,22 @@ namespace PNC
     /// Decorator struct that allocates an Array of Chunks with the same capacity of Nodes per Chunks.
     /// </summary>
     /// <typeparam name="TBase">A ChunkPointer. TODO: ChunkArrayPointer are not yet implemented</typeparam>
-    template<typename TBase>
+    /// <typeparam name="TAllocator">Allocator policy used for all the Array's memory. See ChunkHeapAllocator.</typeparam>
+    template<typename TBase, typename TAllocator = ChunkHeapAllocator>
     struct ChunkArrayAllocationT : public TBase
     {
     public:
         using Base_t = TBase;
-        using Self_t = ChunkArrayAllocationT<TBase>;
+        using Self_t = ChunkArrayAllocationT<TBase, TAllocator>;
         using ChunkStructure_t = typename TBase::ChunkStructure_t;
         using Size_t = typename TBase::Size_t;
         using ChunkPointerElement_t = typename TBase::ChunkPointerElement_t;
+        using Allocator_t = TAllocator;
+        using NodeOccupancy_t = NodeOccupancyT<Size_t>;
 
     protected:
         using Internal_t = ChunkArrayPointerInternalT<ChunkStructure_t, ChunkPointerElement_t>;
+        using ElementInternal_t = ChunkPointerInternalT<ChunkStructure_t>;
 
     protected:
         /// <summary>
@@ -34,6 +42,41 @@ namespace PNC
         /// </summary>
         Size_t ChunkCapacity;
 
+        /// <summary>
+        /// Allocator policy the Array's memory comes from.
+        /// </summary>
+        UE_NO_UNIQUE_ADDRESS Allocator_t Allocator;
+
+        /// <summary>
+        /// What happens to the other Nodes of a Chunk when a Node is removed with RemoveNode.
+        /// </summary>
+        NodeRemovalMode RemovalMode;
+
+        /// <summary>
+        /// Fraction of dead Nodes above which CompactIfFragmented compacts a Chunk, given to the occupancy of every added Chunk.
+        /// </summary>
+        float CompactionThreshold;
+
+        /// <summary>
+        /// Alive Nodes and free slots of each Chunk when RemovalMode is NodeRemovalMode_Stable.
+        /// </summary>
+        std::vector<NodeOccupancy_t> Occupancies;
+
+        /// <summary>
+        /// Address space reservation options. See ChunkVirtualMemoryOptions.
+        /// </summary>
+        ChunkVirtualMemoryOptions VirtualMemory;
+
+        /// <summary>
+        /// Reserved address space of each Component column when VirtualMemory.MaxChunkCapacity is not 0.
+        /// </summary>
+        std::vector<ChunkVirtualColumn> VirtualColumns;
+
+        /// <summary>
+        /// Node count each Chunk of the Array was last counted with in the ChunkStructure's stats.
+        /// </summary>
+        std::vector<Size_t> StatsNodeCounts;
+
     public:
         /// <summary>
         /// Create a Null Chunk
@@ -41,6 +84,9 @@ namespace PNC
         ChunkArrayAllocationT()
             : NodeCapacityPerChunk(0)
             , ChunkCapacity(0)
+            , Allocator()
+            , RemovalMode(NodeRemovalMode_SwapAndPop)
+            , CompactionThreshold(0.25f)
         {
         }
 
@@ -48,25 +94,65 @@ namespace PNC
         /// Allocate a Chunk Array with a maximum number of Chunks and Nodes per Chunks.
         /// </summary>
         /// <param name="chunkStructure">Structure of the Chunk's Component data.</param>
-        /// <param name="nodeCapacityPerChunk">Maximum number of Nodes each Chunks in the Array can grow to.</param>
+        /// <param name="nodeCapacityPerChunk">Maximum number of Nodes each Chunks in the Array can grow to, rounded up to the structure's NodeCapacityMultiple.</param>
         /// <param name="chunkCapacity">Maximum number of Chunks this Array can grow to.</param>
         /// <param name="chunkCount">Number of valid Chunks in the Array.</param>
         /// <param name="nodeCountPerChunk">Number of valid Nodes in each Chunks in the Array.</param>
-        ChunkArrayAllocationT(const ChunkStructure_t* chunkStructure, Size_t nodeCapacityPerChunk, Size_t chunkCapacity, Size_t chunkCount = 0, Size_t nodeCountPerChunk = 0)
-            : Base_t(chunkStructure, chunkCapacity * nodeCapacityPerChunk, chunkCount)
-            , NodeCapacityPerChunk(nodeCapacityPerChunk)
+        /// <param name="allocator">Allocator policy instance the memory comes from.</param>
+        ChunkArrayAllocationT(const ChunkStructure_t* chunkStructure, Size_t nodeCapacityPerChunk, Size_t chunkCapacity, Size_t chunkCount = 0, Size_t nodeCountPerChunk = 0, const Allocator_t& allocator = Allocator_t())
+            : Base_t(chunkStructure, chunkCapacity * chunkStructure->GetLayout().PadNodeCapacity(nodeCapacityPerChunk), chunkCount)
+            , NodeCapacityPerChunk(chunkStructure->GetLayout().PadNodeCapacity(nodeCapacityPerChunk))
             , ChunkCapacity(chunkCapacity)
+            , Allocator(allocator)
+            , RemovalMode(NodeRemovalMode_SwapAndPop)
+            , CompactionThreshold(0.25f)
         {
             AllocateComponentDataArray();
             AllocateData();
             AllocateChunkArray();
             InitChunkArray(nodeCountPerChunk);
+            ConstructChunks(0, chunkCount);
+        }
+
+        /// <summary>
+        /// Allocate a Chunk Array whose Component columns reserve address space for virtualMemory.MaxChunkCapacity Chunks
+        /// and only commit memory for chunkCapacity Chunks. AddChunks then grows the Array without moving Component data.
+        /// </summary>
+        /// <param name="chunkStructure">Structure of the Chunk's Component data.</param>
+        /// <param name="nodeCapacityPerChunk">Maximum number of Nodes each Chunks in the Array can grow to, rounded up to the structure's NodeCapacityMultiple.</param>
+        /// <param name="virtualMemory">Address space reservation options.</param>
+        /// <param name="chunkCapacity">Number of Chunks to commit memory for initially.</param>
+        /// <param name="chunkCount">Number of valid Chunks in the Array.</param>
+        /// <param name="nodeCountPerChunk">Number of valid Nodes in each Chunks in the Array.</param>
+        /// <param name="allocator">Allocator policy instance the Chunk array and Component data pointers come from.</param>
+        ChunkArrayAllocationT(const ChunkStructure_t* chunkStructure, Size_t nodeCapacityPerChunk, const ChunkVirtualMemoryOptions& virtualMemory, Size_t chunkCapacity, Size_t chunkCount = 0, Size_t nodeCountPerChunk = 0, const Allocator_t& allocator = Allocator_t())
+            : Base_t(chunkStructure, chunkCapacity * chunkStructure->GetLayout().PadNodeCapacity(nodeCapacityPerChunk), chunkCount)
+            , NodeCapacityPerChunk(chunkStructure->GetLayout().PadNodeCapacity(nodeCapacityPerChunk))
+            , ChunkCapacity(chunkCapacity)
+            , Allocator(allocator)
+            , RemovalMode(NodeRemovalMode_SwapAndPop)
+            , CompactionThreshold(0.25f)
+            , VirtualMemory(virtualMemory)
+        {
+            assert_pnc(virtualMemory.MaxChunkCapacity >= (SIZE_T)chunkCapacity);
+            // Chunk pointers index the columns with Size_t, every Node of the reservation must stay addressable.
+            assert_pnc(virtualMemory.MaxChunkCapacity * (SIZE_T)NodeCapacityPerChunk <= (SIZE_T)std::numeric_limits<Size_t>::max());
+            AllocateComponentDataArray();
+            AllocateData();
+            AllocateChunkArray();
+            InitChunkArray(nodeCountPerChunk);
+            ConstructChunks(0, chunkCount);
         }
 
         ChunkArrayAllocationT(const ChunkArrayAllocationT& o)
             : Base_t(o)
             , NodeCapacityPerChunk(o.NodeCapacityPerChunk)
             , ChunkCapacity(o.ChunkCapacity)
+            , Allocator(o.Allocator)
+            , RemovalMode(o.RemovalMode)
+            , CompactionThreshold(o.CompactionThreshold)
+            , Occupancies(o.Occupancies)
+            , VirtualMemory(o.VirtualMemory)
         {
             if (o.IsNull())
                 return;
@@ -80,12 +166,20 @@ namespace PNC
         {
             if (this == &o)
                 return *this;
+            ReleaseStats();
+            DestroyChunks();
+            DeallocateChunkArray();
             DeallocateData();
             DeallocateComponentDataArray();
             Base_t::operator=(o);
             NodeCapacityPerChunk = o.NodeCapacityPerChunk;
+            ChunkCapacity = o.ChunkCapacity;
+            RemovalMode = o.RemovalMode;
+            CompactionThreshold = o.CompactionThreshold;
+            Occupancies = o.Occupancies;
+            VirtualMemory = o.VirtualMemory;
             if (o.IsNull())
-                return;
+                return *this;
             AllocateComponentDataArray();
             AllocateDataCopy(o);
             AllocateChunkArray();
@@ -95,6 +189,8 @@ namespace PNC
 
         ~ChunkArrayAllocationT()
         {
+            ReleaseStats();
+            DestroyChunks();
             DeallocateChunkArray();
             DeallocateData();
             DeallocateComponentDataArray();
@@ -121,15 +217,313 @@ namespace PNC
         /// <returns></returns>
         Size_t GetChunkCapacity()const { return ChunkCapacity; }
 
+        /// <summary>
+        /// If the Component columns live in reserved address space and grow without moving.
+        /// </summary>
+        bool IsVirtualMemory()const { return VirtualMemory.MaxChunkCapacity > 0; }
+
+        /// <summary>
+        /// Add Chunks at the end of the Array, growing its capacity if needed.
+        /// With virtual memory, growing only commits more pages and existing Component data never moves.
+        /// Otherwise every Component column is reallocated and copied.
+        /// ChunkPointers to Chunks of the Array are invalidated when the capacity grows.
+        /// </summary>
+        /// <param name="count">Number of Chunks to add.</param>
+        /// <param name="nodeCountPerChunk">Number of valid Nodes in each added Chunk. Their trivial Components are uninitialized, other Components are default constructed.</param>
+        /// <returns>Index of the first added Chunk.</returns>
+        Size_t AddChunks(Size_t count, Size_t nodeCountPerChunk = 0)
+        {
+            auto& chunk = GetInternalChunk();
+            assert_pnc(!chunk.IsNull());
+            assert_pnc(nodeCountPerChunk <= NodeCapacityPerChunk);
+            Size_t first = chunk.Array.ChunkCount;
+            Size_t required = first + count;
+            if (required > ChunkCapacity)
+            {
+                Size_t chunkCapacity = FMath::Max(required, ChunkCapacity * 2);
+                if (IsVirtualMemory())
+                {
+                    assert_pnc((SIZE_T)required <= VirtualMemory.MaxChunkCapacity);
+                    chunkCapacity = (Size_t)FMath::Min((SIZE_T)chunkCapacity, VirtualMemory.MaxChunkCapacity);
+                }
+                Reallocate(chunkCapacity);
+            }
+            for (Size_t i = first; i < required; ++i)
+            {
+                GetInternalElement(i).NodeCount = nodeCountPerChunk;
+                if (RemovalMode == NodeRemovalMode_Stable)
+                {
+                    Occupancies[i].CompactionThreshold = CompactionThreshold;
+                    Occupancies[i].Reset(NodeCapacityPerChunk, nodeCountPerChunk);
+                }
+            }
+            // Reset allocated the bitmaps of the new Chunks after Reallocate bound them.
+            BindOccupancies();
+            ConstructChunks(first, required);
+            chunk.Array.ChunkCount = required;
+            UpdateStats();
+            return first;
+        }
+
+        /// <summary>
+        /// Get what happens to the other Nodes of a Chunk when a Node is removed with RemoveNode.
+        /// </summary>
+        NodeRemovalMode GetNodeRemovalMode()const { return RemovalMode; }
+
+        /// <summary>
+        /// Change what happens to the other Nodes of a Chunk when a Node is removed with RemoveNode.
+        /// Switching away from NodeRemovalMode_Stable compacts every Chunk first.
+        /// </summary>
+        /// <param name="mode"></param>
+        /// <param name="compactionThreshold">Fraction of dead Nodes above which CompactIfFragmented compacts a Chunk.</param>
+        void SetNodeRemovalMode(NodeRemovalMode mode, float compactionThreshold = 0.25f)
+        {
+            auto& chunk = GetInternalChunk();
+            if (RemovalMode == NodeRemovalMode_Stable && mode != NodeRemovalMode_Stable)
+                for (Size_t i = 0; i < chunk.Array.ChunkCount; ++i)
+                    Compact(i);
+            RemovalMode = mode;
+            CompactionThreshold = compactionThreshold;
+            Occupancies.clear();
+            if (mode == NodeRemovalMode_Stable && !chunk.IsNull())
+            {
+                Occupancies.resize(ChunkCapacity);
+                for (Size_t i = 0; i < ChunkCapacity; ++i)
+                {
+                    Occupancies[i].CompactionThreshold = CompactionThreshold;
+                    Occupancies[i].Reset(NodeCapacityPerChunk, (*this)[i].GetNodeCount());
+                }
+            }
+            BindOccupancies();
+        }
+
+        /// <summary>
+        /// Add a single Node to a Chunk of the Array. With NodeRemovalMode_Stable the slot of the last removed Node is reused first.
+        /// Trivial Components of the new Node are uninitialized, other Components are default constructed.
+        /// </summary>
+        /// <param name="chunkIndex">Index of the Chunk in the Array.</param>
+        /// <returns>Index of the added Node in the Chunk or -1 if the Chunk is full.</returns>
+        Size_t AddNode(Size_t chunkIndex)
+        {
+            auto& element = GetInternalElement(chunkIndex);
+            if (RemovalMode == NodeRemovalMode_Stable)
+            {
+                Size_t nodeIndex = Occupancies[chunkIndex].ReviveFreeSlot();
+                if (nodeIndex >= 0)
+                    return nodeIndex;
+            }
+            if (element.NodeCount >= NodeCapacityPerChunk)
+                return (Size_t)-1;
+            Size_t nodeIndex = element.NodeCount++;
+            if (RemovalMode == NodeRemovalMode_Stable)
+                Occupancies[chunkIndex].SetAlive(nodeIndex, nodeIndex + 1);
+            ConstructComponents(chunkIndex, nodeIndex, 1, false);
+            UpdateStats(chunkIndex);
+            return nodeIndex;
+        }
+
+        /// <summary>
+        /// Remove a single Node from a Chunk of the Array according to the Array's NodeRemovalMode.
+        /// See ChunkAllocationT::RemoveNode.
+        /// </summary>
+        /// <param name="chunkIndex">Index of the Chunk in the Array.</param>
+        /// <param name="nodeIndex">Index of an alive Node in the Chunk.</param>
+        void RemoveNode(Size_t chunkIndex, Size_t nodeIndex)
+        {
+            assert_pnc(nodeIndex >= 0 && nodeIndex < (*this)[chunkIndex].GetNodeCount());
+            if (RemovalMode == NodeRemovalMode_Stable)
+            {
+                Occupancies[chunkIndex].Kill(nodeIndex);
+                DestroyComponents(chunkIndex, nodeIndex, 1, false);
+                ConstructComponents(chunkIndex, nodeIndex, 1, false);
+            }
+            else
+            {
+                this->GetChunk().RemoveNodes(chunkIndex, &nodeIndex, 1);
+                UpdateStats(chunkIndex);
+            }
+        }
+
+        /// <summary>
+        /// Test if a Node of a Chunk in the Array is alive. Always true below the Node count unless using NodeRemovalMode_Stable.
+        /// </summary>
+        bool IsNodeAlive(Size_t chunkIndex, Size_t nodeIndex)const
+        {
+            return RemovalMode != NodeRemovalMode_Stable || Occupancies[chunkIndex].IsAlive(nodeIndex);
+        }
+
+        /// <summary>
+        /// Compact a Chunk of the Array if the fraction of its dead Nodes is above the compaction threshold.
+        /// </summary>
+        /// <param name="chunkIndex">Index of the Chunk in the Array.</param>
+        /// <param name="remap">Optional array of at least the Chunk's Node count receiving the new index of each Node or -1 if dead.</param>
+        /// <returns>If the Chunk was compacted.</returns>
+        bool CompactIfFragmented(Size_t chunkIndex, Size_t* remap = nullptr)
+        {
+            if (RemovalMode != NodeRemovalMode_Stable || !Occupancies[chunkIndex].IsFragmented((*this)[chunkIndex].GetNodeCount()))
+                return false;
+            Compact(chunkIndex, remap);
+            return true;
+        }
+
+        /// <summary>
+        /// Remove all dead Nodes of a Chunk in the Array by moving its last alive Nodes into their slots.
+        /// </summary>
+        /// <param name="chunkIndex">Index of the Chunk in the Array.</param>
+        /// <param name="remap">Optional array of at least the Chunk's Node count receiving the new index of each Node or -1 if dead.</param>
+        void Compact(Size_t chunkIndex, Size_t* remap = nullptr)
+        {
+            if (RemovalMode != NodeRemovalMode_Stable)
+                return;
+            auto& occupancy = Occupancies[chunkIndex];
+            std::vector<uint64> deadMask;
+            occupancy.GetDeadMask((*this)[chunkIndex].GetNodeCount(), deadMask);
+            this->GetChunk().RemoveNodesMasked(chunkIndex, deadMask.data(), remap);
+            occupancy.Reset(NodeCapacityPerChunk, (*this)[chunkIndex].GetNodeCount());
+            GetInternalElement(chunkIndex).Occupancy = occupancy.GetBits();
+            UpdateStats(chunkIndex);
+        }
+
+        /// <summary>
+        /// Update the number and occupancy of the Array's Chunks in the ChunkStructure's stats.
+        /// Called by every ChunkArrayAllocationT method changing Node or Chunk counts,
+        /// call it after changing them through a ChunkArrayPointer to this Array.
+        /// </summary>
+        void UpdateStats()
+        {
+            auto& chunk = GetInternalChunk();
+            if (chunk.IsNull())
+                return;
+            auto& stats = chunk.Structure->GetStats();
+            Size_t chunkCount = chunk.Array.ChunkCount;
+            Size_t statsChunkCount = (Size_t)StatsNodeCounts.size();
+            for (Size_t i = chunkCount; i < statsChunkCount; ++i)
+                stats.RemoveChunk(StatsNodeCounts[i], NodeCapacityPerChunk);
+            StatsNodeCounts.resize(chunkCount, 0);
+            for (Size_t i = 0; i < chunkCount; ++i)
+            {
+                if (i >= statsChunkCount)
+                {
+                    StatsNodeCounts[i] = GetInternalElement(i).NodeCount;
+                    stats.AddChunk(StatsNodeCounts[i], NodeCapacityPerChunk);
+                }
+                else
+                    UpdateStats(i);
+            }
+        }
+
+        /// <summary>
+        /// Update the occupancy of a single Chunk of the Array in the ChunkStructure's stats.
+        /// </summary>
+        /// <param name="chunkIndex">Index of a Chunk counted by the last UpdateStats().</param>
+        void UpdateStats(Size_t chunkIndex)
+        {
+            Size_t nodeCount = GetInternalElement(chunkIndex).NodeCount;
+            GetInternalChunk().Structure->GetStats().UpdateOccupancy(StatsNodeCounts[chunkIndex], NodeCapacityPerChunk, nodeCount, NodeCapacityPerChunk);
+            StatsNodeCounts[chunkIndex] = nodeCount;
+        }
+
 
     protected:
         Internal_t& GetInternalChunk() { return (Internal_t&)this->GetChunk(); }
 
+        ElementInternal_t& GetInternalElement(Size_t chunkIndex) { return (ElementInternal_t&)GetInternalChunk().Array.Chunks[chunkIndex]; }
+
+        /// <summary>
+        /// Stop counting all the Array's Chunks in the ChunkStructure's stats.
+        /// </summary>
+        void ReleaseStats()
+        {
+            auto& chunk = GetInternalChunk();
+            if (chunk.Structure == nullptr)
+                return;
+            auto& stats = chunk.Structure->GetStats();
+            for (Size_t nodeCount : StatsNodeCounts)
+                stats.RemoveChunk(nodeCount, NodeCapacityPerChunk);
+            StatsNodeCounts.clear();
+        }
+
+        /// <summary>
+        /// Point every Chunk of the Array to its occupancy bitmap when using NodeRemovalMode_Stable.
+        /// </summary>
+        void BindOccupancies()
+        {
+            auto& chunk = GetInternalChunk();
+            if (chunk.IsNull())
+                return;
+            for (Size_t i = 0; i < ChunkCapacity; ++i)
+                GetInternalElement(i).Occupancy = RemovalMode == NodeRemovalMode_Stable ? Occupancies[i].GetBits() : nullptr;
+        }
+
+        /// <summary>
+        /// Default construct the Components of a range of Nodes in a Chunk of the Array and optionally its Chunk Components.
+        /// </summary>
+        void ConstructComponents(Size_t chunkIndex, Size_t nodeIndex, Size_t count, bool bChunkComponents)
+        {
+            auto& chunk = GetInternalChunk();
+            if (chunk.Structure->GetLayout().bTrivial)
+                return;
+            void** componentData = GetComponentDataForChunk(chunkIndex);
+            auto componentCount = chunk.Structure->Components.GetSize();
+            for (Size_t i = 0; i < componentCount; ++i)
+            {
+                auto componentTypeInfo = chunk.Structure->Components[i];
+                componentTypeInfo->ConstructNodes(componentData[i], nodeIndex, count);
+                if (bChunkComponents)
+                    componentTypeInfo->ConstructChunk(componentData[i]);
+            }
+        }
+
+        /// <summary>
+        /// Destroy the Components of a range of Nodes in a Chunk of the Array and optionally its Chunk Components.
+        /// </summary>
+        void DestroyComponents(Size_t chunkIndex, Size_t nodeIndex, Size_t count, bool bChunkComponents)
+        {
+            auto& chunk = GetInternalChunk();
+            if (chunk.Structure->GetLayout().bTrivial)
+                return;
+            void** componentData = GetComponentDataForChunk(chunkIndex);
+            auto componentCount = chunk.Structure->Components.GetSize();
+            for (Size_t i = 0; i < componentCount; ++i)
+            {
+                auto componentTypeInfo = chunk.Structure->Components[i];
+                componentTypeInfo->DestroyNodes(componentData[i], nodeIndex, count);
+                if (bChunkComponents)
+                    componentTypeInfo->DestroyChunk(componentData[i]);
+            }
+        }
+
+        /// <summary>
+        /// Default construct the Chunk Components and the Components of the valid Nodes of the Chunks in [first, end).
+        /// </summary>
+        void ConstructChunks(Size_t first, Size_t end)
+        {
+            if (this->IsNull())
+                return;
+            for (Size_t k = first; k < end; ++k)
+                ConstructComponents(k, 0, GetInternalElement(k).NodeCount, true);
+        }
+
+        /// <summary>
+        /// Destroy the Chunk Components and the Components of the valid Nodes of every Chunk in the Array.
+        /// With NodeRemovalMode_Stable dead Nodes hold default constructed Components and are destroyed as well.
+        /// </summary>
+        void DestroyChunks()
+        {
+            auto& chunk = GetInternalChunk();
+            if (chunk.Structure == nullptr)
+                return;
+            for (Size_t k = 0; k < chunk.Array.ChunkCount; ++k)
+                DestroyComponents(k, 0, GetInternalElement(k).NodeCount, true);
+        }
+
         void CopyChunkArray(const Self_t& o)
         {
             auto& chunk = GetInternalChunk();
             for (int i = 0; i < ChunkCapacity; ++i)
                 chunk.Array.Chunks[i] = ChunkPointerElement_t(chunk.Structure, o[i].GetNodeCount(), GetComponentDataForChunk(i));
+            BindOccupancies();
+            UpdateStats();
         }
 
         void InitChunkArray(Size_t nodeCountPerChunk = 0)
@@ -141,6 +535,7 @@ namespace PNC
             else
                 for (int i = 0; i < ChunkCapacity; ++i)
                     chunk.Array.Chunks[i] = ChunkPointerElement_t(chunk.Structure, nodeCountPerChunk, GetComponentDataForChunk(i));
+            UpdateStats();
         }
 
         void** GetComponentDataForChunk(Size_t chunkIndex)
@@ -152,24 +547,45 @@ namespace PNC
         void AllocateChunkArray()
         {
             auto& chunk = GetInternalChunk();
-            chunk.Array.Chunks = (ChunkPointerElement_t*)FMemory::Malloc(ChunkCapacity * sizeof(ChunkPointerElement_t), alignof(ChunkPointerElement_t));
+            chunk.Array.Chunks = (ChunkPointerElement_t*)Allocator.Allocate(chunk.Structure, GetNodeCapacityTotal(), GetChunkArraySize(), alignof(ChunkPointerElement_t));
+            chunk.Structure->GetStats().AddBytes(GetChunkArraySize());
         }
 
         void DeallocateChunkArray()
         {
-            FMemory::Free(GetInternalChunk().Array.Chunks);
+            auto& chunk = GetInternalChunk();
+            if (chunk.Structure == nullptr)
+                return;
+            Allocator.Deallocate(chunk.Structure, GetNodeCapacityTotal(), chunk.Array.Chunks, GetChunkArraySize(), alignof(ChunkPointerElement_t));
+            chunk.Structure->GetStats().RemoveBytes(GetChunkArraySize());
+            chunk.Array.Chunks = nullptr;
         }
 
         void AllocateComponentDataArray()
         {
             auto& chunk = GetInternalChunk();
-            chunk.ComponentData = (void**)FMemory::Malloc(ChunkCapacity * chunk.Structure->Components.GetSize() * sizeof(void*), alignof(void*));
+            chunk.ComponentData = (void**)Allocator.Allocate(chunk.Structure, GetNodeCapacityTotal(), GetComponentDataArraySize(), alignof(void*));
+            chunk.Structure->GetStats().AddBytes(GetComponentDataArraySize());
         }
 
         void DeallocateComponentDataArray()
         {
             auto& chunk = GetInternalChunk();
-            FMemory::Free(chunk.ComponentData);
+            if (chunk.Structure == nullptr)
+                return;
+            Allocator.Deallocate(chunk.Structure, GetNodeCapacityTotal(), chunk.ComponentData, GetComponentDataArraySize(), alignof(void*));
+            chunk.Structure->GetStats().RemoveBytes(GetComponentDataArraySize());
+            chunk.ComponentData = nullptr;
+        }
+
+        SIZE_T GetChunkArraySize()const
+        {
+            return (SIZE_T)ChunkCapacity * sizeof(ChunkPointerElement_t);
+        }
+
+        SIZE_T GetComponentDataArraySize()
+        {
+            return (SIZE_T)ChunkCapacity * GetInternalChunk().Structure->Components.GetSize() * sizeof(void*);
         }
 
         void AllocateData()
@@ -178,47 +594,183 @@ namespace PNC
             assert_pnc(!chunk.IsNull());
             auto componentCount = chunk.Structure->Components.GetSize();
             auto nodeCapacityTotal = GetNodeCapacityTotal();
+            if (IsVirtualMemory())
+                VirtualColumns.resize(componentCount);
+            for (size_t i = 0; i < componentCount; ++i)
+            {
+                chunk.ComponentData[i] = AllocateColumn(i, nodeCapacityTotal, ChunkCapacity);
+                PlaceChunkColumns(i);
+            }
+        }
+
+        /// <summary>
+        /// Allocate the memory of a Component column, or reserve its address space and commit the required pages when using virtual memory.
+        /// </summary>
+        void* AllocateColumn(Size_t componentIndex, Size_t nodeCapacityTotal, Size_t chunkCapacity)
+        {
+            auto& chunk = GetInternalChunk();
+            auto componentTypeInfo = chunk.Structure->Components[componentIndex];
+            if (!IsVirtualMemory())
+                return componentTypeInfo->Allocate(Allocator, chunk.Structure, nodeCapacityTotal, chunkCapacity, GetColumnAlignment(componentIndex));
+            auto& column = VirtualColumns[componentIndex];
+            SIZE_T maxChunkCapacity = VirtualMemory.MaxChunkCapacity;
+            column.Reserve(componentTypeInfo->GetAllocationSize(maxChunkCapacity * NodeCapacityPerChunk, maxChunkCapacity), VirtualMemory.bHugePages);
+            CommitColumn(componentIndex, chunkCapacity);
+            return column.GetData();
+        }
+
+        /// <summary>
+        /// Free the memory of a Component column returned by AllocateColumn when not using virtual memory.
+        /// </summary>
+        void DeallocateColumn(Size_t componentIndex, void* data, Size_t nodeCapacityTotal, Size_t chunkCapacity)
+        {
+            auto& chunk = GetInternalChunk();
+            auto componentTypeInfo = chunk.Structure->Components[componentIndex];
+            componentTypeInfo->Deallocate(Allocator, chunk.Structure, data, nodeCapacityTotal, chunkCapacity, GetColumnAlignment(componentIndex));
+        }
+
+        /// <summary>
+        /// Alignment in bytes of a Component column, which is at least the ChunkStructure's column alignment.
+        /// </summary>
+        uint32 GetColumnAlignment(Size_t componentIndex)
+        {
+            const auto* chunkStructure = GetInternalChunk().Structure;
+            return (uint32)FMath::Max(chunkStructure->Components[componentIndex]->Align, chunkStructure->GetLayout().ColumnAlignment);
+        }
+
+        /// <summary>
+        /// Commit the pages of a virtual memory Component column required for a number of Chunks.
+        /// </summary>
+        void CommitColumn(Size_t componentIndex, Size_t chunkCapacity)
+        {
+            auto componentTypeInfo = GetInternalChunk().Structure->Components[componentIndex];
+            SIZE_T prefaultCapacity = FMath::Min((SIZE_T)chunkCapacity + VirtualMemory.PrefaultChunks, VirtualMemory.MaxChunkCapacity);
+            SIZE_T size = componentTypeInfo->GetAllocationSize((SIZE_T)chunkCapacity * NodeCapacityPerChunk, (SIZE_T)chunkCapacity);
+            SIZE_T prefaultSize = componentTypeInfo->GetAllocationSize(prefaultCapacity * NodeCapacityPerChunk, prefaultCapacity) - size;
+            auto& column = VirtualColumns[componentIndex];
+            SIZE_T committedSize = column.GetCommittedSize();
+            column.Commit(size, prefaultSize);
+            GetInternalChunk().Structure->GetStats().AddBytes(column.GetCommittedSize() - committedSize);
+        }
+
+        /// <summary>
+        /// Change the Chunk capacity of the Array.
+        /// Component columns are committed further when using virtual memory, otherwise they are reallocated and copied.
+        /// The Chunk array and Component data pointers are always reallocated.
+        /// </summary>
+        void Reallocate(Size_t chunkCapacity)
+        {
+            auto& chunk = GetInternalChunk();
+            assert_pnc(chunkCapacity >= chunk.Array.ChunkCount);
+            auto componentCount = chunk.Structure->Components.GetSize();
+            Size_t oldChunkCapacity = ChunkCapacity;
+            Size_t oldNodeCapacityTotal = GetNodeCapacityTotal();
+            void** oldComponentData = chunk.ComponentData;
+            ChunkPointerElement_t* oldChunks = chunk.Array.Chunks;
+            SIZE_T oldComponentDataArraySize = GetComponentDataArraySize();
+            SIZE_T oldChunkArraySize = GetChunkArraySize();
+
+            ChunkCapacity = chunkCapacity;
+            chunk.NodeCount = GetNodeCapacityTotal();
+            AllocateComponentDataArray();
             for (size_t i = 0; i < componentCount; ++i)
             {
                 auto componentTypeInfo = chunk.Structure->Components[i];
-                chunk.ComponentData[i] = componentTypeInfo->Allocate(nodeCapacityTotal, ChunkCapacity);
-                for (size_t k = 1; k < ChunkCapacity; ++k)
+                if (IsVirtualMemory())
+                {
+                    CommitColumn(i, chunkCapacity);
+                    chunk.ComponentData[i] = oldComponentData[i];
+                }
+                else
                 {
-                    chunk.ComponentData[k * componentCount + i] = componentTypeInfo->Forward(chunk.ComponentData[i], NodeCapacityPerChunk);
+                    chunk.ComponentData[i] = AllocateColumn(i, GetNodeCapacityTotal(), chunkCapacity);
+                    if (chunk.Structure->GetLayout().bTrivial)
+                        componentTypeInfo->Relocate(chunk.ComponentData[i], oldComponentData[i], oldNodeCapacityTotal, oldChunkCapacity);
+                    else
+                    {
+                        // Only the valid Nodes of each Chunk hold constructed Components.
+                        for (Size_t k = 0; k < chunk.Array.ChunkCount; ++k)
+                        {
+                            void* to = componentTypeInfo->Forward(chunk.ComponentData[i], componentTypeInfo->GetNodeDataIndex(k * NodeCapacityPerChunk, k));
+                            componentTypeInfo->Relocate(to, oldComponentData[k * componentCount + i], oldChunks[k].GetNodeCount(), 1);
+                        }
+                    }
+                    DeallocateColumn(i, oldComponentData[i], oldNodeCapacityTotal, oldChunkCapacity);
                 }
+                PlaceChunkColumns(i);
+            }
+            AllocateChunkArray();
+            for (Size_t i = 0; i < chunkCapacity; ++i)
+                chunk.Array.Chunks[i] = ChunkPointerElement_t(chunk.Structure, i < oldChunkCapacity ? oldChunks[i].GetNodeCount() : 0, GetComponentDataForChunk(i));
+            if (RemovalMode == NodeRemovalMode_Stable)
+                Occupancies.resize(chunkCapacity);
+            BindOccupancies();
+            Allocator.Deallocate(chunk.Structure, oldNodeCapacityTotal, oldChunks, oldChunkArraySize, alignof(ChunkPointerElement_t));
+            Allocator.Deallocate(chunk.Structure, oldNodeCapacityTotal, oldComponentData, oldComponentDataArraySize, alignof(void*));
+            chunk.Structure->GetStats().RemoveBytes(oldChunkArraySize + oldComponentDataArraySize);
+        }
+
+        /// <summary>
+        /// Set the Component data pointer of every Chunk in the Array for a Component column.
+        /// </summary>
+        /// <param name="componentIndex">Index of the component type in the ChunkStructure.</param>
+        void PlaceChunkColumns(Size_t componentIndex)
+        {
+            auto& chunk = GetInternalChunk();
+            auto componentCount = chunk.Structure->Components.GetSize();
+            auto componentTypeInfo = chunk.Structure->Components[componentIndex];
+            for (Size_t k = 1; k < ChunkCapacity; ++k)
+            {
+                chunk.ComponentData[k * componentCount + componentIndex] = componentTypeInfo->Forward(chunk.ComponentData[componentIndex], componentTypeInfo->GetNodeDataIndex(k * NodeCapacityPerChunk, k));
             }
         }
 
         void AllocateDataCopy(const Self_t& o)
         {
             auto& chunk = (Internal_t&)GetInternalChunk();
+            const auto& other = (const Internal_t&)o.GetChunk();
             assert_pnc(!chunk.IsNull());
-            assert_pnc(chunk.IsSameChunkStructure(*this, o));
+            assert_pnc(chunk.Structure == other.Structure);
             auto componentCount = chunk.Structure->Components.GetSize();
             auto nodeCapacityTotal = o.GetNodeCapacityTotal();
+            if (IsVirtualMemory())
+                VirtualColumns.resize(componentCount);
             for (size_t i = 0; i < componentCount; ++i)
             {
                 auto componentTypeInfo = chunk.Structure->Components[i];
-                chunk.ComponentData[i] = componentTypeInfo->AllocateCopy(o.ComponentData[i], nodeCapacityTotal, o.GetChunkCount() * o.GetNodeCapacityPerChunk(), ChunkCapacity);
-                for (size_t k = 1; k < ChunkCapacity; ++k)
-                {
-                    chunk.ComponentData[k * componentCount + i] = componentTypeInfo->Forward(chunk.ComponentData[i], NodeCapacityPerChunk);
-                }
+                chunk.ComponentData[i] = AllocateColumn(i, nodeCapacityTotal, ChunkCapacity);
+                if (chunk.Structure->GetLayout().bTrivial)
+                    componentTypeInfo->Copy(chunk.ComponentData[i], other.ComponentData[i], o.GetChunkCount() * o.GetNodeCapacityPerChunk(), ChunkCapacity);
+                PlaceChunkColumns(i);
+            }
+            if (chunk.Structure->GetLayout().bTrivial)
+                return;
+            // Only the valid Nodes of each Chunk hold constructed Components.
+            for (Size_t k = 0; k < o.GetChunkCount(); ++k)
+            {
+                void** componentData = GetComponentDataForChunk(k);
+                void* const* otherComponentData = &other.ComponentData[k * componentCount];
+                for (size_t i = 0; i < componentCount; ++i)
+                    chunk.Structure->Components[i]->Copy(componentData[i], otherComponentData[i], o[k].GetNodeCount(), 1);
             }
         }
 
         void DeallocateData()
         {
             auto& chunk = GetInternalChunk();
-            if (&chunk.Structure == nullptr)
+            if (chunk.Structure == nullptr)
+                return;
+            if (IsVirtualMemory())
+            {
+                for (const auto& column : VirtualColumns)
+                    chunk.Structure->GetStats().RemoveBytes(column.GetCommittedSize());
+                VirtualColumns.clear();
                 return;
+            }
             auto componentCount = chunk.Structure->Components.GetSize();
             auto nodeCapacityTotal = GetNodeCapacityTotal();
             for (size_t i = 0; i < componentCount; ++i)
-            {
-                auto componentTypeInfo = chunk.Structure->Components[i];
-                componentTypeInfo->Deallocate(chunk.ComponentData[i], nodeCapacityTotal, ChunkCapacity);
-            }
+                DeallocateColumn(i, chunk.ComponentData[i], nodeCapacityTotal, ChunkCapacity);
         }
     };
 }
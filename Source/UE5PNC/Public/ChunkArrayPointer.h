@@ -84,6 +84,33 @@ namespace PNC
         /// <returns></returns>
         Size_t GetChunkCount()const { return Array.ChunkCount; }
 
+        /// <summary>
+        /// Remove a batch of Nodes from a Chunk in the array. See ChunkPointerT::RemoveNodes.
+        /// </summary>
+        /// <param name="chunkIndex">Index of the Chunk in the array.</param>
+        /// <param name="nodeIndices">Indices of the Nodes to remove in the Chunk, sorted in increasing order without duplicates.</param>
+        /// <param name="count">Number of indices.</param>
+        /// <param name="remap">Optional array receiving the new index of each Node of the Chunk or -1 if removed.</param>
+        /// <returns>The new Node count of the Chunk.</returns>
+        Size_t RemoveNodes(Size_t chunkIndex, const Size_t* nodeIndices, Size_t count, Size_t* remap = nullptr)
+        {
+            assert_pnc(chunkIndex >= 0 && chunkIndex < Array.ChunkCount);
+            return Array.Chunks[chunkIndex].RemoveNodes(nodeIndices, count, remap);
+        }
+
+        /// <summary>
+        /// Remove a batch of Nodes from a Chunk in the array. See ChunkPointerT::RemoveNodesMasked.
+        /// </summary>
+        /// <param name="chunkIndex">Index of the Chunk in the array.</param>
+        /// <param name="mask">One bit per Node of the Chunk to remove.</param>
+        /// <param name="remap">Optional array receiving the new index of each Node of the Chunk or -1 if removed.</param>
+        /// <returns>The new Node count of the Chunk.</returns>
+        Size_t RemoveNodesMasked(Size_t chunkIndex, const uint64* mask, Size_t* remap = nullptr)
+        {
+            assert_pnc(chunkIndex >= 0 && chunkIndex < Array.ChunkCount);
+            return Array.Chunks[chunkIndex].RemoveNodesMasked(mask, remap);
+        }
+
         const ChunkPointerElement_t& operator[](Size_t index)const { return Array.Chunks[index]; }
         ChunkPointerElement_t& operator[](Size_t index) { return Array.Chunks[index]; }
         const Chunk_t& GetChunk(Size_t index)const { return Array.Chunks[index]; }
@@ -0,0 +1,252 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "Components.h"
+#include "NodeRemoval.h"
+#include "Routing\SetAlgorithmChunk.h"
+#include "Routing\SkipAlgorithmNode.h"
+#include "Routing\AlgorithmNodeMultiple.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include <atomic>
+
+namespace PNC
+{
+    /// <summary>
+    /// Hierarchy of the Nodes inside a Chunk, given by a CoParentInChunk Component, processed level by level.
+    /// Sort reorders the Chunk's Nodes breadth first: roots first, then their children, and so on, the children of a Node
+    /// being adjacent. Every parent then comes before its children and each depth level is a contiguous range of Nodes,
+    /// so a propagation kernel runs over whole levels with SIMD lanes or worker threads without any dependency inside a level.
+    /// Algorithms executed on the levels declare:
+    ///     void Execute(Size_t nodeCount, Size_t firstNode)
+    /// Node component pointers point to the level's first Node, whose index in the Chunk is firstNode,
+    /// so the parent of Node i is at offset (parents[i].Index - firstNode), which is negative.
+    /// Levels are not block aligned, so algorithms with AlignedColumnT requirements are never executed on them.
+    /// </summary>
+    /// <typeparam name="TSize"></typeparam>
+    template<typename TSize>
+    struct ChunkHierarchyT
+    {
+    public:
+        using Self_t = ChunkHierarchyT<TSize>;
+        using Size_t = TSize;
+        using CoParentInChunk_t = CoParentInChunkT<Size_t>;
+        using CoChildrenInChunk_t = CoChildrenInChunkT<Size_t>;
+
+        /// <summary>
+        /// Default number of Nodes of a level processed at once by a worker in TryRunParallel.
+        /// Levels not larger than that are processed by the calling thread.
+        /// </summary>
+        static constexpr Size_t DefaultRangeSize = 4 * 1024;
+
+    protected:
+        /// <summary>
+        /// First Node of each level followed by the Node count. Level d is [LevelBegins[d], LevelBegins[d + 1]).
+        /// </summary>
+        std::vector<Size_t> LevelBegins;
+
+    public:
+        /// <summary>
+        /// Number of depth levels, 0 until sorted.
+        /// </summary>
+        Size_t GetLevelCount()const { return LevelBegins.empty() ? 0 : (Size_t)LevelBegins.size() - 1; }
+
+        /// <summary>
+        /// Index of the first Node of a level.
+        /// </summary>
+        Size_t GetLevelBegin(Size_t level)const { return LevelBegins[level]; }
+
+        /// <summary>
+        /// Index one past the last Node of a level.
+        /// </summary>
+        Size_t GetLevelEnd(Size_t level)const { return LevelBegins[level + 1]; }
+
+        /// <summary>
+        /// Number of Nodes of the hierarchy when it was sorted.
+        /// </summary>
+        Size_t GetNodeCount()const { return LevelBegins.empty() ? 0 : LevelBegins.back(); }
+
+        /// <summary>
+        /// Reorder the Nodes of a Chunk breadth first and compute the depth levels.
+        /// The CoParentInChunk indices are remapped, and the CoChildrenInChunk Component, if any, is rebuilt.
+        /// A Chunk already in order is left untouched, so calling Sort after adding or removing Nodes keeps the order up to date.
+        /// </summary>
+        /// <param name="chunkPtr">Chunk with a CoParentInChunk Component and without occupancy bitmap.</param>
+        /// <param name="remap">Optional array of GetNodeCount() elements receiving the new index of each Node.</param>
+        /// <returns>False if the Chunk has no CoParentInChunk Component or its parents form a cycle.</returns>
+        template<typename TChunkPointer>
+        bool Sort(TChunkPointer& chunkPtr, Size_t* remap = nullptr)
+        {
+            auto& chunk = *chunkPtr;
+            LevelBegins.clear();
+            const CoParentInChunk_t* parents = chunk.template GetComponentData<CoParentInChunk_t>();
+            if (parents == nullptr)
+                return false;
+            Size_t nodeCount = chunk.GetNodeCount();
+
+            // Children of each Node in increasing index order.
+            std::vector<Size_t> childBegins(nodeCount + 1, 0);
+            std::vector<Size_t> children(nodeCount);
+            std::vector<Size_t> order;
+            order.reserve(nodeCount);
+            for (Size_t i = 0; i < nodeCount; ++i)
+            {
+                Size_t parent = parents[i].Index;
+                assert_pnc(parent >= -1 && parent < nodeCount && parent != i);
+                if (parent < 0)
+                    order.push_back(i);
+                else
+                    ++childBegins[parent + 1];
+            }
+            for (Size_t i = 0; i < nodeCount; ++i)
+                childBegins[i + 1] += childBegins[i];
+            {
+                std::vector<Size_t> cursors(childBegins.begin(), childBegins.end() - 1);
+                for (Size_t i = 0; i < nodeCount; ++i)
+                    if (parents[i].Index >= 0)
+                        children[cursors[parents[i].Index]++] = i;
+            }
+
+            // Breadth first order, one level at a time.
+            LevelBegins.push_back(0);
+            for (Size_t begin = 0; begin < (Size_t)order.size();)
+            {
+                Size_t end = (Size_t)order.size();
+                for (Size_t k = begin; k < end; ++k)
+                    order.insert(order.end(), children.begin() + childBegins[order[k]], children.begin() + childBegins[order[k] + 1]);
+                LevelBegins.push_back(end);
+                begin = end;
+            }
+            if ((Size_t)order.size() != nodeCount)
+            {
+                LevelBegins.clear();
+                return false;
+            }
+
+            std::vector<Size_t> newIndices(nodeCount);
+            bool bMoved = false;
+            for (Size_t k = 0; k < nodeCount; ++k)
+            {
+                newIndices[order[k]] = k;
+                bMoved |= order[k] != k;
+            }
+            if (bMoved)
+            {
+                chunk.PermuteNodes(newIndices.data());
+                NodeRemovalT<Size_t>::RemapParents(chunk.template GetComponentData<CoParentInChunk_t>(), nodeCount, newIndices.data());
+            }
+
+            CoChildrenInChunk_t* childrenInChunk = chunk.template GetComponentData<CoChildrenInChunk_t>();
+            if (childrenInChunk != nullptr)
+            {
+                for (Size_t k = 0; k < nodeCount; ++k)
+                {
+                    Size_t node = order[k];
+                    Size_t count = childBegins[node + 1] - childBegins[node];
+                    childrenInChunk[k].FirstIndex = count > 0 ? newIndices[children[childBegins[node]]] : -1;
+                    childrenInChunk[k].Count = count;
+                }
+            }
+            if (remap != nullptr)
+                FMemory::Memcpy(remap, newIndices.data(), sizeof(Size_t) * nodeCount);
+            return true;
+        }
+
+        /// <summary>
+        /// Route an algorithm on a sorted Chunk and execute it once per level, from the roots down.
+        /// </summary>
+        /// <param name="algorithm">Algorithm with an Execute(Size_t nodeCount, Size_t firstNode).</param>
+        /// <param name="chunkPtr">Chunk sorted by this hierarchy.</param>
+        /// <returns>If the Chunk fulfilled the algorithm requirements, false for algorithms with AlignedColumnT requirements.</returns>
+        template<typename TAlgorithm, typename TChunkPointer>
+        bool TryRun(TAlgorithm& algorithm, TChunkPointer& chunkPtr)const
+        {
+            auto& chunk = *chunkPtr;
+            if (chunk.IsNull())
+                return false;
+            assert_pnc(chunk.GetNodeCount() == GetNodeCount());
+            if (Routing::GetAlgorithmNodeMultiple(algorithm) > 1)
+                return false;
+            if (!algorithm.Requirements(Routing::SetAlgorithmChunk<TChunkPointer>(&chunkPtr)))
+                return false;
+            Size_t cursor = 0;
+            for (Size_t level = 0; level < GetLevelCount(); ++level)
+                ExecuteRange(algorithm, cursor, GetLevelBegin(level), GetLevelEnd(level), chunkPtr);
+            algorithm.Requirements(Routing::SkipAlgorithmNode<TChunkPointer>(-cursor));
+            return true;
+        }
+
+        /// <summary>
+        /// Route an algorithm on a sorted Chunk and execute it level by level, splitting the levels larger than rangeSize
+        /// in ranges processed by worker threads. Each worker owns a copy of the routed algorithm.
+        /// A level is only started once the previous one is complete.
+        /// The algorithm's Execute must only write to the Nodes it is executed on.
+        /// </summary>
+        /// <param name="algorithm">Algorithm with an Execute(Size_t nodeCount, Size_t firstNode), executed on the small levels.</param>
+        /// <param name="chunkPtr">Chunk sorted by this hierarchy.</param>
+        /// <param name="rangeSize">Number of Nodes of a level a worker processes at once.</param>
+        /// <param name="outWorkerAlgorithms">Optional vector receiving the algorithm copy of each worker, to reduce per worker results.</param>
+        /// <returns>If the Chunk fulfilled the algorithm requirements, false for algorithms with AlignedColumnT requirements.</returns>
+        template<typename TAlgorithm, typename TChunkPointer>
+        bool TryRunParallel(TAlgorithm& algorithm, TChunkPointer& chunkPtr, Size_t rangeSize = DefaultRangeSize, std::vector<TAlgorithm>* outWorkerAlgorithms = nullptr)const
+        {
+            auto& chunk = *chunkPtr;
+            if (chunk.IsNull())
+                return false;
+            assert_pnc(chunk.GetNodeCount() == GetNodeCount());
+            if (Routing::GetAlgorithmNodeMultiple(algorithm) > 1)
+                return false;
+            assert_pnc(rangeSize > 0);
+            if (!algorithm.Requirements(Routing::SetAlgorithmChunk<TChunkPointer>(&chunkPtr)))
+                return false;
+            Size_t maxLevelSize = 0;
+            for (Size_t level = 0; level < GetLevelCount(); ++level)
+                maxLevelSize = FMath::Max(maxLevelSize, GetLevelEnd(level) - GetLevelBegin(level));
+            Size_t maxRangeCount = (maxLevelSize + rangeSize - 1) / rangeSize;
+            Size_t workerCount = maxRangeCount > 1 ? FMath::Min(maxRangeCount, (Size_t)FTaskGraphInterface::Get().GetNumWorkerThreads() + 1) : 0;
+            std::vector<TAlgorithm> localWorkerAlgorithms;
+            std::vector<TAlgorithm>& workerAlgorithms = outWorkerAlgorithms != nullptr ? *outWorkerAlgorithms : localWorkerAlgorithms;
+            workerAlgorithms.assign(workerCount, algorithm);
+            std::vector<Size_t> workerCursors(workerCount, 0);
+            Size_t cursor = 0;
+            for (Size_t level = 0; level < GetLevelCount(); ++level)
+            {
+                Size_t levelBegin = GetLevelBegin(level);
+                Size_t levelEnd = GetLevelEnd(level);
+                Size_t rangeCount = (levelEnd - levelBegin + rangeSize - 1) / rangeSize;
+                if (rangeCount <= 1)
+                {
+                    ExecuteRange(algorithm, cursor, levelBegin, levelEnd, chunkPtr);
+                    continue;
+                }
+                std::atomic<Size_t> nextRange(0);
+                ParallelFor(FMath::Min(rangeCount, workerCount), [&](int32 workerIndex)
+                    {
+                        for (Size_t range = nextRange.fetch_add(1, std::memory_order_relaxed); range < rangeCount; range = nextRange.fetch_add(1, std::memory_order_relaxed))
+                        {
+                            Size_t begin = levelBegin + range * rangeSize;
+                            ExecuteRange(workerAlgorithms[workerIndex], workerCursors[workerIndex], begin, FMath::Min(levelEnd, begin + rangeSize), chunkPtr);
+                        }
+                    });
+            }
+            algorithm.Requirements(Routing::SkipAlgorithmNode<TChunkPointer>(-cursor));
+            for (Size_t i = 0; i < workerCount; ++i)
+                workerAlgorithms[i].Requirements(Routing::SkipAlgorithmNode<TChunkPointer>(-workerCursors[i]));
+            return true;
+        }
+
+    protected:
+        /// <summary>
+        /// Move a routed algorithm from the Node at cursor to the Node begin and execute it on [begin, end).
+        /// </summary>
+        template<typename TAlgorithm, typename TChunkPointer>
+        static void ExecuteRange(TAlgorithm& algorithm, Size_t& cursor, Size_t begin, Size_t end, const TChunkPointer&)
+        {
+            algorithm.Requirements(Routing::SkipAlgorithmNode<TChunkPointer>(begin - cursor));
+            cursor = begin;
+            algorithm.Execute(end - begin, begin);
+        }
+    };
+}
@@ -0,0 +1,232 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "ComponentTypeSet.h"
+
+namespace PNC
+{
+    /// <summary>
+    /// Describes how the Component data of a Chunk is placed in a single block of memory.
+    /// The block starts with the array of Component data pointers followed by every Component column.
+    /// Columns are ordered by decreasing alignment so no padding is required between them.
+    /// The layout is computed once per ChunkStructure and only the Node capacity varies between Chunks.
+    /// </summary>
+    /// <typeparam name="TSize"></typeparam>
+    template< typename TSize>
+    struct ChunkLayoutT
+    {
+    public:
+        using Self_t = ChunkLayoutT<TSize>;
+        using Size_t = TSize;
+        using ComponentTypeSet_t = ComponentTypeSetT<TSize>;
+        using ComponentType_t = typename ComponentTypeSet_t::ComponentType_t;
+
+        /// <summary>
+        /// Placement information of a single Component column in the block.
+        /// </summary>
+        struct Column
+        {
+            /// <summary>
+            /// Index of the component type in the ChunkStructure ComponentTypeSet.
+            /// </summary>
+            Size_t ComponentIndex;
+
+            /// <summary>
+            /// Size of a single component instance in bytes.
+            /// </summary>
+            Size_t Size;
+
+            /// <summary>
+            /// Alignment of the column in bytes.
+            /// </summary>
+            Size_t Align;
+
+            /// <summary>
+            /// Owner of the component, determine if the column holds one instance per Node or per Chunk.
+            /// </summary>
+            ComponentOwner Owner;
+        };
+
+    public:
+        /// <summary>
+        /// Columns in the order they are placed in the block.
+        /// </summary>
+        std::vector<Column> Columns;
+
+        /// <summary>
+        /// Number of Component data pointers at the beginning of the block.
+        /// </summary>
+        Size_t ComponentCount;
+
+        /// <summary>
+        /// Offset in bytes from the beginning of the block to the first column.
+        /// Includes the Component data pointers array and its padding.
+        /// </summary>
+        SIZE_T DataOffset;
+
+        /// <summary>
+        /// Alignment in bytes of the whole block.
+        /// </summary>
+        Size_t Alignment;
+
+        /// <summary>
+        /// Minimum alignment in bytes of every column, 1 if columns only use their component's alignment.
+        /// </summary>
+        Size_t ColumnAlignment;
+
+        /// <summary>
+        /// Node capacities are rounded up to a multiple of this number so every ComponentOwner_Node column
+        /// ends on a ColumnAlignment boundary and holds whole blocks of split components. Always a power of two.
+        /// </summary>
+        Size_t NodeCapacityMultiple;
+
+        /// <summary>
+        /// If every component is trivial, in which case whole blocks can be copied with a single memcpy
+        /// and nothing needs to run when Nodes are created or destroyed.
+        /// </summary>
+        bool bTrivial;
+
+        /// <summary>
+        /// Sum of the size of all ComponentOwner_Node components.
+        /// </summary>
+        SIZE_T BytesPerNode;
+
+        /// <summary>
+        /// Sum of the size of all ComponentOwner_Chunk components.
+        /// </summary>
+        SIZE_T BytesPerChunk;
+
+    public:
+        /// <summary>
+        /// Create an empty layout.
+        /// </summary>
+        ChunkLayoutT()
+            : ComponentCount(0)
+            , DataOffset(0)
+            , Alignment(alignof(void*))
+            , ColumnAlignment(1)
+            , NodeCapacityMultiple(1)
+            , bTrivial(true)
+            , BytesPerNode(0)
+            , BytesPerChunk(0)
+        {
+        }
+
+        /// <summary>
+        /// Compute the layout of a ComponentTypeSet.
+        /// </summary>
+        /// <param name="components"></param>
+        /// <param name="columnAlignment">Minimum alignment in bytes of every column, a power of two. 1 to use each component's alignment.</param>
+        ChunkLayoutT(const ComponentTypeSet_t& components, Size_t columnAlignment = 1)
+            : ChunkLayoutT()
+        {
+            Build(components, columnAlignment);
+        }
+
+    public:
+        /// <summary>
+        /// Round a Node capacity up so every ComponentOwner_Node column ends on a ColumnAlignment boundary.
+        /// </summary>
+        Size_t PadNodeCapacity(Size_t nodeCapacity)const
+        {
+            return Align(nodeCapacity, NodeCapacityMultiple);
+        }
+
+        /// <summary>
+        /// If every column of a Chunk using this layout starts on an alignment boundary and holds a whole number of aligned blocks.
+        /// </summary>
+        /// <param name="alignment">Alignment in bytes, a power of two.</param>
+        bool IsColumnAligned(SIZE_T alignment)const
+        {
+            return (SIZE_T)ColumnAlignment >= alignment;
+        }
+
+        /// <summary>
+        /// Get the size in bytes of a block that can fit a Chunk of the given Node capacity.
+        /// </summary>
+        /// <param name="nodeCapacity">Maximum number of Nodes of the Chunk.</param>
+        /// <returns>Size of the block in bytes</returns>
+        SIZE_T GetBlockSize(Size_t nodeCapacity)const
+        {
+            SIZE_T offset = DataOffset;
+            for (const auto& column : Columns)
+            {
+                offset = Align(offset, column.Align);
+                offset += GetColumnSize(column, nodeCapacity);
+            }
+            return offset;
+        }
+
+        /// <summary>
+        /// Get the size in bytes of the Component data of a Chunk, which is the block size without the Component data pointers.
+        /// </summary>
+        /// <param name="nodeCapacity">Maximum number of Nodes of the Chunk.</param>
+        SIZE_T GetDataSize(Size_t nodeCapacity)const
+        {
+            return GetBlockSize(nodeCapacity) - DataOffset;
+        }
+
+        /// <summary>
+        /// Write the Component data pointers at the beginning of a block so each points to its column.
+        /// </summary>
+        /// <param name="block">Memory of at least GetBlockSize(nodeCapacity) bytes aligned to Alignment.</param>
+        /// <param name="nodeCapacity">Maximum number of Nodes of the Chunk.</param>
+        /// <returns>The Component data pointers array, which is the beginning of the block.</returns>
+        void** PlaceColumns(void* block, Size_t nodeCapacity)const
+        {
+            assert_pnc(IsAligned(block, Alignment));
+            void** componentData = (void**)block;
+            SIZE_T offset = DataOffset;
+            for (const auto& column : Columns)
+            {
+                offset = Align(offset, column.Align);
+                componentData[column.ComponentIndex] = (uint8*)block + offset;
+                offset += GetColumnSize(column, nodeCapacity);
+            }
+            return componentData;
+        }
+
+    protected:
+        static SIZE_T GetColumnSize(const Column& column, Size_t nodeCapacity)
+        {
+            return (SIZE_T)column.Size * (column.Owner == ComponentOwner_Node ? nodeCapacity : 1);
+        }
+
+        void Build(const ComponentTypeSet_t& components, Size_t columnAlignment)
+        {
+            assert_pnc(FMath::IsPowerOfTwo(columnAlignment));
+            ComponentCount = components.GetSize();
+            Columns.clear();
+            Columns.reserve(ComponentCount);
+            Alignment = FMath::Max((Size_t)alignof(void*), columnAlignment);
+            ColumnAlignment = columnAlignment;
+            NodeCapacityMultiple = 1;
+            bTrivial = true;
+            BytesPerNode = 0;
+            BytesPerChunk = 0;
+            for (Size_t i = 0; i < ComponentCount; ++i)
+            {
+                const ComponentType_t* componentType = components[i];
+                Size_t align = FMath::Max(componentType->Align, columnAlignment);
+                Columns.push_back(Column{ i, componentType->Size, align, componentType->Owner });
+                Alignment = FMath::Max(Alignment, align);
+                bTrivial = bTrivial && componentType->IsTrivial();
+                if (componentType->Owner == ComponentOwner_Node)
+                {
+                    BytesPerNode += componentType->Size;
+                    // Nodes per aligned block is columnAlignment / gcd(Size, columnAlignment), the lowest set bit of Size bounds the gcd.
+                    Size_t sizeAlignment = FMath::Min(componentType->Size & -componentType->Size, columnAlignment);
+                    NodeCapacityMultiple = FMath::Max(NodeCapacityMultiple, columnAlignment / sizeAlignment);
+                    // Split columns are only cut between blocks.
+                    NodeCapacityMultiple = FMath::Max(NodeCapacityMultiple, componentType->SplitBlockNodes);
+                }
+                else
+                    BytesPerChunk += componentType->Size;
+            }
+            std::stable_sort(Columns.begin(), Columns.end(), [](const Column& a, const Column& b) { return a.Align > b.Align; });
+            DataOffset = Align((SIZE_T)ComponentCount * sizeof(void*), Alignment);
+        }
+    };
+}
@@ -3,6 +3,7 @@
 
 #pragma once
 #include "ChunkPointerInternal.h"
+#include "NodeRemoval.h"
 
 namespace PNC
 {
@@ -55,7 +56,7 @@ namespace PNC
 
     protected:
         ChunkPointerT(const ChunkStructure_t* chunkStructure, Size_t nodeCount)
-            : Base_t(chunkStructure, nullptr, nodeCount)
+            : Base_t(chunkStructure, nodeCount)
         {
         }
 
@@ -63,6 +64,7 @@ namespace PNC
         using Base_t::IsNull;
         using Base_t::GetNodeCount;
         using Base_t::GetChunkStructure;
+        using Base_t::GetOccupancy;
 
         /// <summary>
         /// Create a null chunk without structure nor component data.
@@ -147,8 +149,8 @@ namespace PNC
         /// Get the pointer to a component's memory array using the component's typename.
         /// For components with ComponentOwner_Node, the array will be at least the length of the size of the chunk.
         /// For components with ComponentOwner_Chunk, the array will be of length 1.
-        /// This is a slow way to access the chunk's component data as it require to do a map lookup of the associated
-        /// component typename const type_info* pointer to the component type index in the chunk's ChunkStructure ComponentTypeSet.
+        /// The component's ComponentId is mapped to the component type index with a single table load in the chunk's ChunkStructure ComponentTypeSet.
+        /// When ChunkStructure_t is a StaticChunkStructureT the index is known at compile time and no lookup is done.
         /// </summary>
         /// <typeparam name="TComponent">Component typename for the desired component's memory array</typeparam>
         /// <returns>Pointer to the component memory array</returns>
@@ -156,15 +158,29 @@ namespace PNC
         TComponent* GetComponentData()
         {
             assert_pnc(!IsNull());
-            return (TComponent*)this->GetComponentData(&typeid(TComponent));
+            if constexpr (ChunkStructure_t::bStatic)
+            {
+                constexpr Size_t index = ChunkStructure_t::template GetComponentIndex<TComponent>();
+                if constexpr (index < 0)
+                    return nullptr;
+                else
+                    return (TComponent*)this->GetComponentData(index);
+            }
+            else
+            {
+                auto index = this->Structure->Components.GetComponentTypeIndexInChunk(ComponentRegistry::GetId<TComponent>());
+                if (index < 0)
+                    return nullptr;
+                return (TComponent*)this->GetComponentData(index);
+            }
         }
 
         /// <summary>
         /// Get the const pointer to a component's memory array using the component's typename.
         /// For components with ComponentOwner_Node, the array will be at least the length of the size of the chunk.
         /// For components with ComponentOwner_Chunk, the array will be of length 1.
-        /// This is a slow way to access the chunk's component data as it require to do a map lookup of the associated
-        /// component typename const type_info* pointer to the component type index in the chunk's ChunkStructure ComponentTypeSet.
+        /// The component's ComponentId is mapped to the component type index with a single table load in the chunk's ChunkStructure ComponentTypeSet.
+        /// When ChunkStructure_t is a StaticChunkStructureT the index is known at compile time and no lookup is done.
         /// </summary>
         /// <typeparam name="TComponent">Component typename for the desired component's memory array</typeparam>
         /// <returns>Const Pointer to the component memory array</returns>
@@ -172,7 +188,21 @@ namespace PNC
         const TComponent* GetComponentData()const
         {
             assert_pnc(!IsNull());
-            return (TComponent*)this->GetComponentData(&typeid(TComponent));
+            if constexpr (ChunkStructure_t::bStatic)
+            {
+                constexpr Size_t index = ChunkStructure_t::template GetComponentIndex<TComponent>();
+                if constexpr (index < 0)
+                    return nullptr;
+                else
+                    return (TComponent*)this->GetComponentData(index);
+            }
+            else
+            {
+                auto index = this->Structure->Components.GetComponentTypeIndexInChunk(ComponentRegistry::GetId<TComponent>());
+                if (index < 0)
+                    return nullptr;
+                return (TComponent*)this->GetComponentData(index);
+            }
         }
 
         /// <summary>
@@ -193,12 +223,138 @@ namespace PNC
             for (Size_t i = 0; i < componentCount; ++i)
             {
                 auto componentTypeInfo = chunkStructure->Components[i];
+                componentTypeInfo->DestroyNodes(destination.ComponentData[i], 0, destination.NodeCount);
+                componentTypeInfo->DestroyChunk(destination.ComponentData[i]);
                 componentTypeInfo->Copy(destination.ComponentData[i], source.ComponentData[i], count);
             }
             destination.NodeCount = count;
             return count;
         }
 
+        /// <summary>
+        /// Remove a batch of Nodes by moving the last surviving Nodes into the removed slots.
+        /// Every Component column is compacted in a single pass and the Node count is reduced.
+        /// Nodes are reordered, use remap to fix up any Node index such as CoParentInChunk (see NodeRemovalT::RemapParents).
+        /// </summary>
+        /// <param name="nodeIndices">Indices of the Nodes to remove, sorted in increasing order without duplicates.</param>
+        /// <param name="count">Number of indices.</param>
+        /// <param name="remap">Optional array of at least GetNodeCount() elements receiving the new index of each Node or -1 if removed.</param>
+        /// <returns>The new Node count.</returns>
+        Size_t RemoveNodes(const Size_t* nodeIndices, Size_t count, Size_t* remap = nullptr)
+        {
+            NodeRemovalT<Size_t> removal;
+            removal.Build(nodeIndices, count, this->NodeCount);
+            return ApplyNodeRemoval(removal, remap);
+        }
+
+        /// <summary>
+        /// Remove a batch of Nodes by moving the last surviving Nodes into the removed slots.
+        /// Every Component column is compacted in a single pass and the Node count is reduced.
+        /// Nodes are reordered, use remap to fix up any Node index such as CoParentInChunk (see NodeRemovalT::RemapParents).
+        /// </summary>
+        /// <param name="mask">One bit per Node to remove, Node i is bit (i % 64) of word (i / 64). Must cover GetNodeCount() bits.</param>
+        /// <param name="remap">Optional array of at least GetNodeCount() elements receiving the new index of each Node or -1 if removed.</param>
+        /// <returns>The new Node count.</returns>
+        Size_t RemoveNodesMasked(const uint64* mask, Size_t* remap = nullptr)
+        {
+            NodeRemovalT<Size_t> removal;
+            removal.BuildFromMask(mask, this->NodeCount);
+            return ApplyNodeRemoval(removal, remap);
+        }
+
+        /// <summary>
+        /// Apply a removal plan built for this chunk's Node count.
+        /// The Components of the removed Nodes are destroyed and the surviving Nodes are relocated into their slots.
+        /// </summary>
+        /// <param name="removal">Removal plan.</param>
+        /// <param name="remap">Optional array of at least GetNodeCount() elements receiving the new index of each Node or -1 if removed.</param>
+        /// <returns>The new Node count.</returns>
+        Size_t ApplyNodeRemoval(const NodeRemovalT<Size_t>& removal, Size_t* remap = nullptr)
+        {
+            assert_pnc(!IsNull());
+            assert_pnc(removal.OldNodeCount == this->NodeCount);
+            if (remap != nullptr)
+                removal.WriteRemap(remap);
+            auto componentCount = this->Structure->Components.GetSize();
+            Size_t moveCount = (Size_t)removal.Holes.size();
+            for (Size_t i = 0; i < componentCount; ++i)
+            {
+                auto componentTypeInfo = this->Structure->Components[i];
+                componentTypeInfo->DestroyNodes(this->ComponentData[i], removal.Removed.data(), (Size_t)removal.Removed.size());
+                componentTypeInfo->MoveNodes(this->ComponentData[i], removal.Sources.data(), removal.Holes.data(), moveCount);
+            }
+            this->NodeCount = removal.NewNodeCount;
+            return this->NodeCount;
+        }
+
+        /// <summary>
+        /// Reorder the Nodes, the Node at index i moves to index newIndices[i].
+        /// Each cycle of the permutation is rotated through a single Node buffer: the Node of its first slot is parked,
+        /// each slot is filled with the Node moving into it with one MoveNodes pass, then the parked Node is moved to the last slot.
+        /// No Node slot past the Node count is used, so any Chunk can be reordered whatever its capacity.
+        /// Node indices stored in Components such as CoParentInChunk must be remapped with newIndices afterward (see NodeRemovalT::RemapParents).
+        /// </summary>
+        /// <param name="newIndices">New index of each Node, a permutation of [0, GetNodeCount()).</param>
+        void PermuteNodes(const Size_t* newIndices)
+        {
+            assert_pnc(!IsNull());
+            assert_pnc(this->Occupancy == nullptr);
+            Size_t nodeCount = this->NodeCount;
+            std::vector<Size_t> oldIndices(nodeCount);
+            for (Size_t i = 0; i < nodeCount; ++i)
+                oldIndices[newIndices[i]] = i;
+
+            // Moves of every cycle one after the other, cycle c being [cycleBegins[c], cycleBegins[c + 1]) and ending in slot cycleLasts[c].
+            std::vector<bool> visited(nodeCount, false);
+            std::vector<Size_t> from;
+            std::vector<Size_t> to;
+            std::vector<Size_t> cycleStarts;
+            std::vector<Size_t> cycleLasts;
+            std::vector<Size_t> cycleBegins;
+            for (Size_t start = 0; start < nodeCount; ++start)
+            {
+                if (visited[start] || oldIndices[start] == start)
+                    continue;
+                cycleStarts.push_back(start);
+                cycleBegins.push_back((Size_t)from.size());
+                Size_t slot = start;
+                visited[slot] = true;
+                while (oldIndices[slot] != start)
+                {
+                    from.push_back(oldIndices[slot]);
+                    to.push_back(slot);
+                    slot = oldIndices[slot];
+                    visited[slot] = true;
+                }
+                cycleLasts.push_back(slot);
+            }
+            if (cycleStarts.empty())
+                return;
+            cycleBegins.push_back((Size_t)from.size());
+
+            auto componentCount = this->Structure->Components.GetSize();
+            SIZE_T bufferSize = 0;
+            SIZE_T bufferAlign = 1;
+            for (Size_t i = 0; i < componentCount; ++i)
+            {
+                bufferSize = FMath::Max(bufferSize, (SIZE_T)this->Structure->Components[i]->Size);
+                bufferAlign = FMath::Max(bufferAlign, (SIZE_T)this->Structure->Components[i]->Align);
+            }
+            void* buffer = FMemory::Malloc(bufferSize, (uint32)bufferAlign);
+            for (Size_t i = 0; i < componentCount; ++i)
+            {
+                auto componentTypeInfo = this->Structure->Components[i];
+                void* data = this->ComponentData[i];
+                for (Size_t c = 0; c < (Size_t)cycleStarts.size(); ++c)
+                {
+                    componentTypeInfo->ParkNode(data, cycleStarts[c], buffer);
+                    componentTypeInfo->MoveNodes(data, from.data() + cycleBegins[c], to.data() + cycleBegins[c], cycleBegins[c + 1] - cycleBegins[c]);
+                    componentTypeInfo->UnparkNode(data, cycleLasts[c], buffer);
+                }
+            }
+            FMemory::Free(buffer);
+        }
+
         /// <summary>
         /// Test if 2 chunk have the same ChunkStructure
         /// </summary>
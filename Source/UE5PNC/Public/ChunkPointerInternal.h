@@ -35,6 +35,12 @@ namespace PNC
         /// </summary>
         Size_t NodeCount;
 
+        /// <summary>
+        /// Occupancy bitmap of the nodes when the chunk uses NodeRemovalMode_Stable, see NodeOccupancyT.
+        /// Null when every node below NodeCount is alive.
+        /// </summary>
+        const uint64* Occupancy;
+
     public:
         /// <summary>
         /// Create a null ChunkRefT without structure nor data.
@@ -44,6 +50,7 @@ namespace PNC
             : Structure(nullptr)
             , ComponentData(nullptr)
             , NodeCount(0)
+            , Occupancy(nullptr)
         {
         }
 
@@ -51,6 +58,7 @@ namespace PNC
             : Structure(chunkStructure)
             , ComponentData(componentData)
             , NodeCount(nodeCount)
+            , Occupancy(nullptr)
         {
         }
 
@@ -58,6 +66,7 @@ namespace PNC
             : Structure(chunkStructure)
             , ComponentData(nullptr)
             , NodeCount(nodeCount)
+            , Occupancy(nullptr)
         {
         }
 
@@ -76,6 +85,12 @@ namespace PNC
         /// <returns>The capacity of the chunk</returns>
         Size_t GetNodeCount()const { return this->NodeCount; }
 
+        /// <summary>
+        /// Get the occupancy bitmap of the chunk's nodes, or null if every node below the node count is alive.
+        /// Node i is alive when bit (i % 64) of word (i / 64) is set.
+        /// </summary>
+        const uint64* GetOccupancy()const { return this->Occupancy; }
+
         /// <summary>
         /// Get the ChunkStructure of this chunk
         /// </summary>
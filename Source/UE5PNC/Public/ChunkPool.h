@@ -0,0 +1,131 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+
+namespace PNC
+{
+    /// <summary>
+    /// Recycles freed Chunk memory so spawning and destroying Chunks of the same shape does not go through FMemory.
+    /// Memory blocks are grouped by ChunkStructure, Node capacity, size and alignment.
+    /// Each thread keeps a small cache of free blocks that it can reuse without locking.
+    /// The cache overflows into, and refills from, a shared pool protected by a lock.
+    /// </summary>
+    struct UE5PNC_API ChunkPool
+    {
+    public:
+        /// <summary>
+        /// Identify a group of interchangeable memory blocks.
+        /// </summary>
+        struct Key
+        {
+            const void* ChunkStructure;
+            SIZE_T NodeCapacity;
+            SIZE_T Size;
+            uint32 Alignment;
+
+            bool operator==(const Key& o)const
+            {
+                return ChunkStructure == o.ChunkStructure
+                    && NodeCapacity == o.NodeCapacity
+                    && Size == o.Size
+                    && Alignment == o.Alignment;
+            }
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(const Key& key)const
+            {
+                size_t hash = std::hash<const void*>()(key.ChunkStructure);
+                hash = hash * 31 + std::hash<SIZE_T>()(key.NodeCapacity);
+                hash = hash * 31 + std::hash<SIZE_T>()(key.Size);
+                return hash * 31 + key.Alignment;
+            }
+        };
+
+        using FreeList_t = std::vector<void*>;
+        using FreeListMap_t = std::unordered_map<Key, FreeList_t, KeyHash>;
+
+    public:
+        /// <summary>
+        /// Maximum number of free blocks each thread keeps per Key before giving them back to the shared pool.
+        /// </summary>
+        int32 MaxThreadCacheBlocks = 16;
+
+    protected:
+        FCriticalSection Lock;
+        FreeListMap_t Shared;
+        std::atomic<SIZE_T> PooledBytes;
+
+    public:
+        ChunkPool();
+        ~ChunkPool();
+        ChunkPool(const ChunkPool&) = delete;
+        ChunkPool& operator=(const ChunkPool&) = delete;
+
+        /// <summary>
+        /// Get the process wide pool used by ChunkPoolAllocator.
+        /// </summary>
+        static ChunkPool& Get();
+
+        /// <summary>
+        /// Get a free block matching the key or allocate a new one.
+        /// </summary>
+        void* Allocate(const Key& key);
+
+        /// <summary>
+        /// Give back a block previously returned by Allocate with the same key.
+        /// </summary>
+        void Deallocate(const Key& key, void* ptr);
+
+        /// <summary>
+        /// Free every block in the shared pool and in the calling thread's cache.
+        /// Blocks cached by other threads are freed when those threads trim or exit.
+        /// </summary>
+        void Trim();
+
+        /// <summary>
+        /// Free every block of a given ChunkStructure in the shared pool and in the calling thread's cache.
+        /// Must be called before destroying a ChunkStructure that was used with the pool.
+        /// </summary>
+        void Trim(const void* chunkStructure);
+
+        /// <summary>
+        /// Give back all blocks cached by the calling thread to the shared pool.
+        /// </summary>
+        void FlushThreadCache();
+
+        /// <summary>
+        /// Total bytes currently held by the pool, including all thread caches.
+        /// </summary>
+        SIZE_T GetPooledBytes()const { return PooledBytes.load(std::memory_order_relaxed); }
+
+    protected:
+        struct ThreadCache;
+        static ThreadCache& GetThreadCache();
+        void ReleaseToShared(FreeListMap_t& lists);
+        void FreeBlocks(FreeListMap_t& lists, const void* chunkStructure);
+    };
+
+    /// <summary>
+    /// Allocator policy that recycles Chunk memory through the ChunkPool.
+    /// Use it for Chunks that are frequently created and destroyed with the same structure and capacity.
+    /// </summary>
+    struct ChunkPoolAllocator
+    {
+    public:
+        template<typename TChunkStructure>
+        void* Allocate(const TChunkStructure* chunkStructure, SIZE_T nodeCapacity, SIZE_T size, uint32 alignment)
+        {
+            return ChunkPool::Get().Allocate(ChunkPool::Key{ chunkStructure, nodeCapacity, size, alignment });
+        }
+
+        template<typename TChunkStructure>
+        void Deallocate(const TChunkStructure* chunkStructure, SIZE_T nodeCapacity, void* ptr, SIZE_T size, uint32 alignment)
+        {
+            ChunkPool::Get().Deallocate(ChunkPool::Key{ chunkStructure, nodeCapacity, size, alignment }, ptr);
+        }
+    };
+}
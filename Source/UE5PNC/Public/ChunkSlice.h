@@ -0,0 +1,112 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "ChunkPointer.h"
+
+namespace PNC
+{
+    /// <summary>
+    /// A ChunkSlice is a ChunkPointer over a range of Nodes of another Chunk without copying any Component data.
+    /// ComponentOwner_Node columns point to the first Node of the range and ComponentOwner_Chunk columns are shared with the Chunk.
+    /// The slice only owns its array of Component data pointers and must not outlive the Chunk's data.
+    /// Since Nodes of a slice are Nodes of the Chunk, adding or removing Nodes must be done on the Chunk.
+    /// </summary>
+    /// <typeparam name="TChunkStructure">Structure of the Chunk's Component data.</typeparam>
+    template<typename TChunkStructure>
+    struct ChunkSliceT : public ChunkPointerT<TChunkStructure>
+    {
+    public:
+        using Base_t = ChunkPointerT<TChunkStructure>;
+        using Self_t = ChunkSliceT<TChunkStructure>;
+        using ChunkStructure_t = TChunkStructure;
+        using Size_t = typename ChunkStructure_t::Size_t;
+        using Internal_t = ChunkPointerInternalT<ChunkStructure_t>;
+
+        /// <summary>
+        /// Nodes per occupancy bitmap word. Slices of a Chunk with an occupancy bitmap must start on a multiple of it.
+        /// </summary>
+        static constexpr Size_t OccupancyGranularity = 64;
+
+    protected:
+        /// <summary>
+        /// Component data pointers of the slice, one per component type of the ChunkStructure.
+        /// </summary>
+        std::vector<void*> SliceComponentData;
+
+    public:
+        /// <summary>
+        /// Create a null slice.
+        /// IsNull() will evaluate to true.
+        /// </summary>
+        ChunkSliceT()
+            : Base_t()
+        {
+        }
+
+        /// <summary>
+        /// Create a slice over a range of Nodes of a Chunk.
+        /// </summary>
+        /// <param name="chunk">Chunk to slice.</param>
+        /// <param name="firstNode">Index of the first Node of the slice in the Chunk.</param>
+        /// <param name="nodeCount">Number of Nodes in the slice.</param>
+        ChunkSliceT(const Base_t& chunk, Size_t firstNode, Size_t nodeCount)
+            : Base_t()
+        {
+            Reset(chunk, firstNode, nodeCount);
+        }
+
+        ChunkSliceT(const Self_t& o)
+            : Base_t(o)
+            , SliceComponentData(o.SliceComponentData)
+        {
+            BindComponentData();
+        }
+
+        Self_t& operator=(const Self_t& o)
+        {
+            Base_t::operator=(o);
+            SliceComponentData = o.SliceComponentData;
+            BindComponentData();
+            return *this;
+        }
+
+    public:
+        /// <summary>
+        /// Point the slice to another range of Nodes. The array of Component data pointers is reused.
+        /// </summary>
+        /// <param name="chunk">Chunk to slice.</param>
+        /// <param name="firstNode">Index of the first Node of the slice in the Chunk.</param>
+        /// <param name="nodeCount">Number of Nodes in the slice.</param>
+        void Reset(const Base_t& chunk, Size_t firstNode, Size_t nodeCount)
+        {
+            assert_pnc(!chunk.IsNull());
+            assert_pnc(firstNode >= 0 && nodeCount >= 0 && firstNode + nodeCount <= chunk.GetNodeCount());
+            const auto& source = (const Internal_t&)chunk;
+            auto& slice = GetInternalChunk();
+            auto& components = source.Structure->Components;
+            Size_t componentCount = components.GetSize();
+            SliceComponentData.resize(componentCount);
+            for (Size_t i = 0; i < componentCount; ++i)
+                SliceComponentData[i] = components[i]->SubChunk(source.ComponentData[i], firstNode);
+            slice.Structure = source.Structure;
+            slice.NodeCount = nodeCount;
+            slice.Occupancy = nullptr;
+            if (source.Occupancy != nullptr)
+            {
+                assert_pnc(firstNode % OccupancyGranularity == 0);
+                slice.Occupancy = source.Occupancy + firstNode / OccupancyGranularity;
+            }
+            BindComponentData();
+        }
+
+    protected:
+        Internal_t& GetInternalChunk() { return (Internal_t&)this->GetChunk(); }
+
+        void BindComponentData()
+        {
+            GetInternalChunk().ComponentData = SliceComponentData.data();
+        }
+    };
+}
@@ -0,0 +1,216 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+
+namespace PNC
+{
+    /// <summary>
+    /// Memory and occupancy counters of all the Chunks using a ChunkStructure.
+    /// Maintained by ChunkAllocationT and ChunkArrayAllocationT, safe to update and read from any thread.
+    /// </summary>
+    struct ChunkStructureStats
+    {
+    public:
+        /// <summary>
+        /// Number of buckets of the occupancy histogram.
+        /// Bucket i counts the Chunks whose NodeCount / NodeCapacity is in [i / OccupancyBucketCount, (i + 1) / OccupancyBucketCount),
+        /// full Chunks are counted in the last bucket.
+        /// </summary>
+        static constexpr int32 OccupancyBucketCount = 8;
+
+        /// <summary>
+        /// Copy of the counters at a point in time.
+        /// </summary>
+        struct Snapshot
+        {
+            int64 LiveChunks = 0;
+            int64 CommittedBytes = 0;
+            int64 PeakBytes = 0;
+            int64 NodeCount = 0;
+            int64 NodeCapacity = 0;
+            int64 OccupancyHistogram[OccupancyBucketCount] = {};
+
+            /// <summary>
+            /// Fraction of the Node capacity of all Chunks that holds Nodes.
+            /// </summary>
+            double GetOccupancy()const { return NodeCapacity > 0 ? (double)NodeCount / (double)NodeCapacity : 0.0; }
+        };
+
+    protected:
+        std::atomic<int64> LiveChunks;
+        std::atomic<int64> CommittedBytes;
+        std::atomic<int64> PeakBytes;
+        std::atomic<int64> NodeCount;
+        std::atomic<int64> NodeCapacity;
+        std::atomic<int64> OccupancyHistogram[OccupancyBucketCount];
+
+    public:
+        ChunkStructureStats()
+            : LiveChunks(0)
+            , CommittedBytes(0)
+            , PeakBytes(0)
+            , NodeCount(0)
+            , NodeCapacity(0)
+        {
+            for (auto& bucket : OccupancyHistogram)
+                bucket.store(0, std::memory_order_relaxed);
+        }
+
+        /// <summary>
+        /// A copied ChunkStructure has no Chunk yet so its counters start at zero.
+        /// </summary>
+        ChunkStructureStats(const ChunkStructureStats&)
+            : ChunkStructureStats()
+        {
+        }
+
+        ChunkStructureStats& operator=(const ChunkStructureStats&)
+        {
+            return *this;
+        }
+
+    public:
+        /// <summary>
+        /// Get the histogram bucket of a Chunk's occupancy.
+        /// </summary>
+        static int32 GetOccupancyBucket(int64 nodeCount, int64 nodeCapacity)
+        {
+            if (nodeCapacity <= 0)
+                return 0;
+            return (int32)FMath::Min<int64>(nodeCount * OccupancyBucketCount / nodeCapacity, OccupancyBucketCount - 1);
+        }
+
+        void AddBytes(SIZE_T bytes)
+        {
+            int64 committed = CommittedBytes.fetch_add((int64)bytes, std::memory_order_relaxed) + (int64)bytes;
+            int64 peak = PeakBytes.load(std::memory_order_relaxed);
+            while (committed > peak && !PeakBytes.compare_exchange_weak(peak, committed, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        void RemoveBytes(SIZE_T bytes)
+        {
+            CommittedBytes.fetch_sub((int64)bytes, std::memory_order_relaxed);
+        }
+
+        /// <summary>
+        /// Count a new Chunk with its current Node count and capacity.
+        /// </summary>
+        void AddChunk(int64 nodeCount, int64 nodeCapacity)
+        {
+            LiveChunks.fetch_add(1, std::memory_order_relaxed);
+            AddOccupancy(nodeCount, nodeCapacity);
+        }
+
+        /// <summary>
+        /// Stop counting a Chunk with the Node count and capacity it was last counted with.
+        /// </summary>
+        void RemoveChunk(int64 nodeCount, int64 nodeCapacity)
+        {
+            LiveChunks.fetch_sub(1, std::memory_order_relaxed);
+            RemoveOccupancy(nodeCount, nodeCapacity);
+        }
+
+        /// <summary>
+        /// Move a Chunk from the occupancy it was last counted with to its current one.
+        /// </summary>
+        void UpdateOccupancy(int64 oldNodeCount, int64 oldNodeCapacity, int64 nodeCount, int64 nodeCapacity)
+        {
+            if (oldNodeCount == nodeCount && oldNodeCapacity == nodeCapacity)
+                return;
+            RemoveOccupancy(oldNodeCount, oldNodeCapacity);
+            AddOccupancy(nodeCount, nodeCapacity);
+        }
+
+        /// <summary>
+        /// Read all the counters. Counters are read one by one so the snapshot is only consistent when no other thread allocates.
+        /// </summary>
+        Snapshot GetSnapshot()const
+        {
+            Snapshot snapshot;
+            snapshot.LiveChunks = LiveChunks.load(std::memory_order_relaxed);
+            snapshot.CommittedBytes = CommittedBytes.load(std::memory_order_relaxed);
+            snapshot.PeakBytes = PeakBytes.load(std::memory_order_relaxed);
+            snapshot.NodeCount = NodeCount.load(std::memory_order_relaxed);
+            snapshot.NodeCapacity = NodeCapacity.load(std::memory_order_relaxed);
+            for (int32 i = 0; i < OccupancyBucketCount; ++i)
+                snapshot.OccupancyHistogram[i] = OccupancyHistogram[i].load(std::memory_order_relaxed);
+            return snapshot;
+        }
+
+        /// <summary>
+        /// Restart the peak at the current number of committed bytes.
+        /// </summary>
+        void ResetPeak()
+        {
+            PeakBytes.store(CommittedBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+
+    protected:
+        void AddOccupancy(int64 nodeCount, int64 nodeCapacity)
+        {
+            NodeCount.fetch_add(nodeCount, std::memory_order_relaxed);
+            NodeCapacity.fetch_add(nodeCapacity, std::memory_order_relaxed);
+            OccupancyHistogram[GetOccupancyBucket(nodeCount, nodeCapacity)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void RemoveOccupancy(int64 nodeCount, int64 nodeCapacity)
+        {
+            NodeCount.fetch_sub(nodeCount, std::memory_order_relaxed);
+            NodeCapacity.fetch_sub(nodeCapacity, std::memory_order_relaxed);
+            OccupancyHistogram[GetOccupancyBucket(nodeCount, nodeCapacity)].fetch_sub(1, std::memory_order_relaxed);
+        }
+    };
+
+    /// <summary>
+    /// Process wide list of the live ChunkStructures and their counters.
+    /// ChunkStructures register themselves on construction and unregister on destruction.
+    /// </summary>
+    struct UE5PNC_API ChunkStatsRegistry
+    {
+    public:
+        struct Entry
+        {
+            const void* ChunkStructure;
+            const ChunkStructureStats* Stats;
+
+            /// <summary>
+            /// Names of the ChunkStructure's component types separated by '+'.
+            /// </summary>
+            FString Name;
+        };
+
+    protected:
+        mutable FCriticalSection Lock;
+        std::vector<Entry> Entries;
+
+    public:
+        /// <summary>
+        /// Get the process wide registry.
+        /// </summary>
+        static ChunkStatsRegistry& Get();
+
+        void Register(const void* chunkStructure, const ChunkStructureStats* stats, const FString& name);
+        void Unregister(const void* chunkStructure);
+
+        /// <summary>
+        /// Copy the list of registered ChunkStructures.
+        /// </summary>
+        std::vector<Entry> GetEntries()const;
+
+        /// <summary>
+        /// Format the counters of every registered ChunkStructure as CSV, one line per ChunkStructure.
+        /// </summary>
+        FString GetReport()const;
+
+        /// <summary>
+        /// Write GetReport() to a file.
+        /// </summary>
+        /// <param name="filename">Path of the file to write.</param>
+        /// <returns>If the file was written.</returns>
+        bool DumpToFile(const FString& filename)const;
+    };
+}
@@ -4,6 +4,8 @@
 #pragma once
 #include "common.h"
 #include "ComponentTypeSet.h"
+#include "ChunkLayout.h"
+#include "ChunkStats.h"
 
 namespace PNC
 {
@@ -19,6 +21,17 @@ namespace PNC
         using Size_t = TSize;
         using ComponentTypeSet_t = ComponentTypeSetT<TSize>;
         using ComponentType_t = typename ComponentTypeSet_t::ComponentType_t;
+        using ChunkLayout_t = ChunkLayoutT<TSize>;
+
+        /// <summary>
+        /// Column alignment matching the width of the widest vector registers and a cache line.
+        /// </summary>
+        static constexpr Size_t SimdColumnAlignment = 64;
+
+        /// <summary>
+        /// If the component indices are known at compile time. See StaticChunkStructureT.
+        /// </summary>
+        static constexpr bool bStatic = false;
 
     public:
         /// <summary>
@@ -26,11 +39,98 @@ namespace PNC
         /// </summary>
         ComponentTypeSet_t Components;
 
+        /// <summary>
+        /// Placement of the Component columns in a Chunk's memory block.
+        /// </summary>
+        ChunkLayout_t Layout;
+
+        /// <summary>
+        /// Memory and occupancy counters of all the Chunks using this ChunkStructure.
+        /// </summary>
+        mutable ChunkStructureStats Stats;
+
         /// <summary>
         /// Create a ChunkStructure from a list of ComponentType
         /// </summary>
         /// <param name="components"></param>
-        ChunkStructureT(std::initializer_list<const ComponentType_t*> components) :Components(components) {}
+        ChunkStructureT(std::initializer_list<const ComponentType_t*> components) 
+            : Components(components)
+            , Layout(Components)
+        {
+            ChunkStatsRegistry::Get().Register(this, &Stats, GetName());
+        }
+
+        /// <summary>
+        /// Create a ChunkStructure from a list of ComponentType whose columns are all aligned to columnAlignment bytes.
+        /// Node capacities of Chunks using this structure are padded so every Node column is a whole number of aligned blocks,
+        /// which lets vector loops run over full-width lanes without a scalar prologue or tail. See AlignedColumnT.
+        /// ex.: ChunkStructure structure(ChunkStructure::SimdColumnAlignment, { &position, &velocity });
+        /// </summary>
+        /// <param name="columnAlignment">Minimum alignment in bytes of every column, a power of two.</param>
+        /// <param name="components"></param>
+        ChunkStructureT(Size_t columnAlignment, std::initializer_list<const ComponentType_t*> components)
+            : Components(components)
+            , Layout(Components, columnAlignment)
+        {
+            ChunkStatsRegistry::Get().Register(this, &Stats, GetName());
+        }
+
+        /// <summary>
+        /// Create a ChunkStructure extending another one with more ComponentType.
+        /// The base structure's components keep the same indices, which lets a ChunkArena attach scratch columns to existing Chunks.
+        /// The extended structure keeps the column alignment of the base structure.
+        /// </summary>
+        /// <param name="base">Structure whose components come first.</param>
+        /// <param name="components">Components added after the base structure's components.</param>
+        ChunkStructureT(const Self& base, std::initializer_list<const ComponentType_t*> components)
+            : Components(base.Components, components)
+            , Layout(Components, base.Layout.ColumnAlignment)
+        {
+            ChunkStatsRegistry::Get().Register(this, &Stats, GetName());
+        }
+
+        ChunkStructureT(const Self& o)
+            : Components(o.Components)
+            , Layout(o.Layout)
+        {
+            ChunkStatsRegistry::Get().Register(this, &Stats, GetName());
+        }
+
+        ~ChunkStructureT()
+        {
+            ChunkStatsRegistry::Get().Unregister(this);
+        }
+
+        /// <summary>
+        /// Get the placement of the Component columns in a Chunk's memory block.
+        /// </summary>
+        const ChunkLayout_t& GetLayout()const { return Layout; }
+
+        /// <summary>
+        /// Get the bitset of the component types of this ChunkStructure.
+        /// </summary>
+        const ComponentSignature& GetSignature()const { return Components.GetSignature(); }
+
+        /// <summary>
+        /// Get the memory and occupancy counters of all the Chunks using this ChunkStructure.
+        /// Counters are updated through a const ChunkStructure since Chunks only hold const pointers to their structure.
+        /// </summary>
+        ChunkStructureStats& GetStats()const { return Stats; }
+
+        /// <summary>
+        /// Get a readable name made of the names of the component types separated by '+'.
+        /// </summary>
+        FString GetName()const
+        {
+            FString name;
+            for (Size_t i = 0; i < Components.GetSize(); ++i)
+            {
+                if (i > 0)
+                    name += TEXT("+");
+                name += ANSI_TO_TCHAR(Components[i]->TypeInfo->name());
+            }
+            return name;
+        }
 
         /// <summary>
         /// Get the index of a component type in the ComponentTypeSet of this ChunkStructure
@@ -38,5 +138,12 @@ namespace PNC
         /// <param name="type"></param>
         /// <returns></returns>
         int GetComponentTypeIndexInChunk(const type_info* type)const { return Components.GetComponentTypeIndexInChunk(type); }
+
+        /// <summary>
+        /// Get the index of a component type in the ComponentTypeSet of this ChunkStructure from its ComponentId
+        /// </summary>
+        /// <param name="id"></param>
+        /// <returns></returns>
+        int GetComponentTypeIndexInChunk(ComponentId id)const { return Components.GetComponentTypeIndexInChunk(id); }
     };
 }
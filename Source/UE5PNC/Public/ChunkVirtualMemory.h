@@ -0,0 +1,158 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "Tasks/Task.h"
+#if PLATFORM_LINUX
+#   include <sys/mman.h>
+#endif
+
+namespace PNC
+{
+    /// <summary>
+    /// Options to reserve the address space of a ChunkArrayAllocationT up front.
+    /// Each Component column reserves enough address space for MaxChunkCapacity Chunks and only commits pages
+    /// for the Chunks actually allocated, so adding Chunks never moves existing Component data.
+    /// </summary>
+    struct ChunkVirtualMemoryOptions
+    {
+    public:
+        /// <summary>
+        /// Maximum number of Chunks the Array can ever grow to. 0 disables the address space reservation.
+        /// </summary>
+        SIZE_T MaxChunkCapacity = 0;
+
+        /// <summary>
+        /// Ask the OS to back the columns with transparent huge pages when available.
+        /// </summary>
+        bool bHugePages = false;
+
+        /// <summary>
+        /// Number of Chunks past the committed ones whose pages are committed ahead and faulted in on a background task.
+        /// </summary>
+        SIZE_T PrefaultChunks = 0;
+    };
+
+    /// <summary>
+    /// A range of reserved address space whose pages are committed in increasing order as it grows.
+    /// Committed memory never moves.
+    /// </summary>
+    struct ChunkVirtualColumn
+    {
+    public:
+        using Self_t = ChunkVirtualColumn;
+
+    protected:
+        FPlatformVirtualMemoryBlock Block;
+
+        /// <summary>
+        /// Number of bytes committed from the beginning of the block.
+        /// </summary>
+        SIZE_T CommittedSize;
+
+        /// <summary>
+        /// Background task faulting in the pages committed ahead. Must complete before the block is freed.
+        /// </summary>
+        UE::Tasks::FTask PrefaultTask;
+
+    public:
+        static constexpr SIZE_T HugePageSize = 2 * 1024 * 1024;
+
+        ChunkVirtualColumn()
+            : CommittedSize(0)
+        {
+        }
+
+        ChunkVirtualColumn(const ChunkVirtualColumn&) = delete;
+        ChunkVirtualColumn& operator=(const ChunkVirtualColumn&) = delete;
+
+        ChunkVirtualColumn(ChunkVirtualColumn&& o)
+            : Block(o.Block)
+            , CommittedSize(o.CommittedSize)
+            , PrefaultTask(MoveTemp(o.PrefaultTask))
+        {
+            o.Block = FPlatformVirtualMemoryBlock();
+            o.CommittedSize = 0;
+        }
+
+        ~ChunkVirtualColumn()
+        {
+            Free();
+        }
+
+    public:
+        void* GetData()const { return Block.GetVirtualPointer(); }
+        SIZE_T GetCommittedSize()const { return CommittedSize; }
+        SIZE_T GetReservedSize()const { return Block.GetActualSize(); }
+
+        /// <summary>
+        /// Reserve address space without committing any memory.
+        /// </summary>
+        /// <param name="size">Size in bytes to reserve.</param>
+        /// <param name="bHugePages">Hint the OS to back the range with transparent huge pages.</param>
+        void Reserve(SIZE_T size, bool bHugePages)
+        {
+            assert_pnc(GetData() == nullptr);
+            SIZE_T alignment = FPlatformVirtualMemoryBlock::GetVirtualSizeAlignment();
+            if (bHugePages)
+                alignment = FMath::Max(alignment, HugePageSize);
+            Block = FPlatformVirtualMemoryBlock::AllocateVirtual(Align(FMath::Max(size, (SIZE_T)1), alignment), alignment);
+            CommittedSize = 0;
+#if PLATFORM_LINUX && defined(MADV_HUGEPAGE)
+            if (bHugePages)
+                madvise(Block.GetVirtualPointer(), Block.GetActualSize(), MADV_HUGEPAGE);
+#endif
+        }
+
+        /// <summary>
+        /// Make sure at least the first size bytes are committed.
+        /// </summary>
+        /// <param name="size">Size in bytes required.</param>
+        /// <param name="prefaultSize">Extra bytes to commit ahead and fault in on a background task.</param>
+        void Commit(SIZE_T size, SIZE_T prefaultSize = 0)
+        {
+            if (size <= CommittedSize)
+                return;
+            SIZE_T commitAlignment = FPlatformVirtualMemoryBlock::GetCommitAlignment();
+            SIZE_T begin = CommittedSize;
+            SIZE_T end = FMath::Min(Align(size + prefaultSize, commitAlignment), GetReservedSize());
+            assert_pnc(size <= end);
+            Block.Commit(begin, end - begin);
+            CommittedSize = end;
+            SIZE_T prefaultBegin = Align(size, commitAlignment);
+            if (prefaultSize > 0 && prefaultBegin < end)
+                Prefault(prefaultBegin, end - prefaultBegin);
+        }
+
+        /// <summary>
+        /// Release the whole reserved range.
+        /// </summary>
+        void Free()
+        {
+            if (GetData() == nullptr)
+                return;
+            PrefaultTask.Wait();
+            Block.FreeVirtual();
+            Block = FPlatformVirtualMemoryBlock();
+            CommittedSize = 0;
+        }
+
+    protected:
+        /// <summary>
+        /// Fault in committed pages on a background task so the first write to them does not stall.
+        /// The pages are populated by the kernel without touching their content.
+        /// </summary>
+        void Prefault(SIZE_T offset, SIZE_T size)
+        {
+#if PLATFORM_LINUX && defined(MADV_POPULATE_WRITE)
+            PrefaultTask.Wait();
+            uint8* ptr = (uint8*)Block.GetVirtualPointer() + offset;
+            PrefaultTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [ptr, size]()
+                {
+                    madvise(ptr, size, MADV_POPULATE_WRITE);
+                });
+#endif
+        }
+    };
+}
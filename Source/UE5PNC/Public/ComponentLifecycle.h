@@ -0,0 +1,136 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include <new>
+#include <type_traits>
+
+namespace PNC
+{
+    /// <summary>
+    /// Type-erased batched kernels constructing, copying, relocating and destroying component instances.
+    /// Each kernel processes a whole range of instances with a single indirect call.
+    /// A null kernel means the operation is trivial for the component type: nothing to do for
+    /// construction and destruction, a memcpy for copy and relocation.
+    /// </summary>
+    /// <typeparam name="TSize"></typeparam>
+    template< typename TSize>
+    struct ComponentLifecycleT
+    {
+    public:
+        using Self_t = ComponentLifecycleT<TSize>;
+        using Size_t = TSize;
+
+        using Construct_t = void(*)(void* data, SIZE_T count);
+        using Destroy_t = void(*)(void* data, SIZE_T count);
+        using CopyConstruct_t = void(*)(void* to, const void* from, SIZE_T count);
+        using Relocate_t = void(*)(void* to, void* from, SIZE_T count);
+        using DestroyIndexed_t = void(*)(void* data, const Size_t* indices, Size_t count);
+        using RelocateIndexed_t = void(*)(void* data, const Size_t* from, const Size_t* to, Size_t count);
+
+    public:
+        /// <summary>
+        /// Default construct count instances in uninitialized memory.
+        /// </summary>
+        Construct_t Construct = nullptr;
+
+        /// <summary>
+        /// Destroy count instances, leaving uninitialized memory.
+        /// </summary>
+        Destroy_t Destroy = nullptr;
+
+        /// <summary>
+        /// Copy construct count instances into uninitialized memory that does not overlap the source.
+        /// </summary>
+        CopyConstruct_t CopyConstruct = nullptr;
+
+        /// <summary>
+        /// Move construct count instances into uninitialized memory that does not overlap the source, then destroy the source instances.
+        /// </summary>
+        Relocate_t Relocate = nullptr;
+
+        /// <summary>
+        /// Destroy the instances at a list of indices.
+        /// </summary>
+        DestroyIndexed_t DestroyIndexed = nullptr;
+
+        /// <summary>
+        /// Relocate the instance at from[i] into the uninitialized slot at to[i] for each i, within the same array.
+        /// </summary>
+        RelocateIndexed_t RelocateIndexed = nullptr;
+
+    public:
+        /// <summary>
+        /// If every operation is trivial for the component type.
+        /// </summary>
+        bool IsTrivial()const
+        {
+            return Construct == nullptr && Destroy == nullptr && CopyConstruct == nullptr && Relocate == nullptr;
+        }
+
+        /// <summary>
+        /// Generate the kernels of a component type at compile time.
+        /// Kernels of operations that are trivial for T are left null so callers take the memcpy or no-op path.
+        /// </summary>
+        template<typename T>
+        static Self_t Make()
+        {
+            Self_t lifecycle;
+            if constexpr (!std::is_trivially_default_constructible_v<T>)
+            {
+                lifecycle.Construct = [](void* data, SIZE_T count)
+                    {
+                        T* instances = (T*)data;
+                        for (SIZE_T i = 0; i < count; ++i)
+                            new (instances + i) T();
+                    };
+            }
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                lifecycle.Destroy = [](void* data, SIZE_T count)
+                    {
+                        T* instances = (T*)data;
+                        for (SIZE_T i = 0; i < count; ++i)
+                            instances[i].~T();
+                    };
+                lifecycle.DestroyIndexed = [](void* data, const Size_t* indices, Size_t count)
+                    {
+                        T* instances = (T*)data;
+                        for (Size_t i = 0; i < count; ++i)
+                            instances[indices[i]].~T();
+                    };
+            }
+            if constexpr (!std::is_trivially_copyable_v<T>)
+            {
+                lifecycle.CopyConstruct = [](void* to, const void* from, SIZE_T count)
+                    {
+                        T* destination = (T*)to;
+                        const T* source = (const T*)from;
+                        for (SIZE_T i = 0; i < count; ++i)
+                            new (destination + i) T(source[i]);
+                    };
+                lifecycle.Relocate = [](void* to, void* from, SIZE_T count)
+                    {
+                        T* destination = (T*)to;
+                        T* source = (T*)from;
+                        for (SIZE_T i = 0; i < count; ++i)
+                        {
+                            new (destination + i) T(MoveTemp(source[i]));
+                            source[i].~T();
+                        }
+                    };
+                lifecycle.RelocateIndexed = [](void* data, const Size_t* from, const Size_t* to, Size_t count)
+                    {
+                        T* instances = (T*)data;
+                        for (Size_t i = 0; i < count; ++i)
+                        {
+                            new (instances + to[i]) T(MoveTemp(instances[from[i]]));
+                            instances[from[i]].~T();
+                        }
+                    };
+            }
+            return lifecycle;
+        }
+    };
+}
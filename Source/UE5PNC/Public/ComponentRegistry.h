@@ -0,0 +1,75 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include <type_traits>
+#include <typeindex>
+
+namespace PNC
+{
+    /// <summary>
+    /// Small dense integer identifying a component type in the process, from 0 to ComponentRegistry::GetCount() - 1.
+    /// -1 is never a valid id.
+    /// </summary>
+    using ComponentId = int32;
+
+    /// <summary>
+    /// Process wide list of the component types assigning each a ComponentId on first registration.
+    /// Ids are dense so a ComponentTypeSet can map them to component indices with a flat array instead of a hash map.
+    /// </summary>
+    struct UE5PNC_API ComponentRegistry
+    {
+    protected:
+        mutable FCriticalSection Lock;
+        std::unordered_map<std::type_index, ComponentId> TypeToId;
+        std::vector<const type_info*> Types;
+
+    public:
+        /// <summary>
+        /// Get the process wide registry.
+        /// </summary>
+        static ComponentRegistry& Get();
+
+        /// <summary>
+        /// Get the id of a component type known at compile time.
+        /// The id is registered on the first call and cached, so later calls are a single load.
+        /// </summary>
+        /// <typeparam name="T">Component type, cv-qualifiers are ignored.</typeparam>
+        template<typename T>
+        static ComponentId GetId()
+        {
+            if constexpr (!std::is_same_v<T, std::remove_cv_t<T>>)
+                return GetId<std::remove_cv_t<T>>();
+            else
+            {
+                static const ComponentId id = Get().Register(&typeid(T));
+                return id;
+            }
+        }
+
+        /// <summary>
+        /// Get the id of a component type, assigning the next free id if the type was never registered.
+        /// </summary>
+        /// <param name="type">type_info of the component type. ex. &typeid(MyComponent)</param>
+        ComponentId Register(const type_info* type);
+
+        /// <summary>
+        /// Get the id of an already registered component type.
+        /// This requires a hash map lookup, prefer GetId<T>() or ComponentTypeT::Id.
+        /// </summary>
+        /// <param name="type">type_info of the component type. ex. &typeid(MyComponent)</param>
+        /// <returns>Id of the component type or -1 if it was never registered.</returns>
+        ComponentId Find(const type_info* type)const;
+
+        /// <summary>
+        /// Get the number of registered component types, all ids are lower than this.
+        /// </summary>
+        ComponentId GetCount()const;
+
+        /// <summary>
+        /// Get the type_info of a registered component type.
+        /// </summary>
+        const type_info* GetTypeInfo(ComponentId id)const;
+    };
+}
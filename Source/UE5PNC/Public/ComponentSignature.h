@@ -0,0 +1,95 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "ComponentRegistry.h"
+
+namespace PNC
+{
+    /// <summary>
+    /// Set of component types stored as a bitset indexed by ComponentId.
+    /// Testing if a set of component types contains another is a single AND and compare per 64 ids.
+    /// </summary>
+    struct ComponentSignature
+    {
+    public:
+        using Self_t = ComponentSignature;
+        static constexpr int32 BitsPerWord = 64;
+
+    protected:
+        /// <summary>
+        /// Bit i of word w is set if ComponentId w * BitsPerWord + i is in the set. Trailing zero words are never stored.
+        /// </summary>
+        std::vector<uint64> Words;
+
+    public:
+        ComponentSignature() {}
+
+        /// <summary>
+        /// Add a component type to the set.
+        /// </summary>
+        void Add(ComponentId id)
+        {
+            assert_pnc(id >= 0);
+            SIZE_T word = (SIZE_T)id / BitsPerWord;
+            if (word >= Words.size())
+                Words.resize(word + 1, 0);
+            Words[word] |= (uint64)1 << (id % BitsPerWord);
+        }
+
+        /// <summary>
+        /// Add every component type of another set.
+        /// </summary>
+        void Add(const Self_t& o)
+        {
+            if (o.Words.size() > Words.size())
+                Words.resize(o.Words.size(), 0);
+            for (SIZE_T i = 0; i < o.Words.size(); ++i)
+                Words[i] |= o.Words[i];
+        }
+
+        /// <summary>
+        /// If a component type is in the set.
+        /// </summary>
+        bool Has(ComponentId id)const
+        {
+            SIZE_T word = (SIZE_T)(uint32)id / BitsPerWord;
+            return word < Words.size() && (Words[word] >> (id % BitsPerWord) & 1) != 0;
+        }
+
+        /// <summary>
+        /// If every component type of a required set is in this set.
+        /// </summary>
+        /// <param name="required">Component types to look for.</param>
+        bool Contains(const Self_t& required)const
+        {
+            // Trailing zero words are never stored so a longer required set always has a bit past this set.
+            if (required.Words.size() > Words.size())
+                return false;
+            for (SIZE_T i = 0; i < required.Words.size(); ++i)
+                if ((Words[i] & required.Words[i]) != required.Words[i])
+                    return false;
+            return true;
+        }
+
+        /// <summary>
+        /// If at least one component type is in both sets.
+        /// </summary>
+        bool Intersects(const Self_t& o)const
+        {
+            SIZE_T count = FMath::Min(Words.size(), o.Words.size());
+            for (SIZE_T i = 0; i < count; ++i)
+                if ((Words[i] & o.Words[i]) != 0)
+                    return true;
+            return false;
+        }
+
+        bool IsEmpty()const { return Words.empty(); }
+
+        void Reset() { Words.clear(); }
+
+        bool operator==(const Self_t& o)const { return Words == o.Words; }
+        bool operator!=(const Self_t& o)const { return Words != o.Words; }
+    };
+}
@@ -3,6 +3,8 @@
 
 #pragma once
 #include "common.h"
+#include "ComponentLifecycle.h"
+#include "ComponentRegistry.h"
 
 namespace PNC
 {
@@ -35,25 +37,53 @@ namespace PNC
     public:
         using Self_t = ComponentTypeT<TSize>;
         using Size_t = TSize;
+        using ComponentLifecycle_t = ComponentLifecycleT<TSize>;
 
     public:
         const type_info* TypeInfo;
+
+        /// <summary>
+        /// Dense id of the component type in the ComponentRegistry.
+        /// </summary>
+        ComponentId Id;
+
         Size_t Size;
         Size_t Align;
         ComponentOwner Owner;
 
+        /// <summary>
+        /// Kernels constructing, copying, relocating and destroying instances of the component.
+        /// </summary>
+        ComponentLifecycle_t Lifecycle;
+
+        /// <summary>
+        /// Number of Nodes per block of a ComponentOwner_Node component split by field, see SplitNodeComponent.
+        /// 0 when instances are stored whole one after another.
+        /// </summary>
+        Size_t SplitBlockNodes;
+
+        /// <summary>
+        /// Size in bytes of each field of a split component, 0 when not split.
+        /// </summary>
+        Size_t SplitFieldSize;
+
         /// <summary>
         /// Create a ComponentType from the component's type_info.
         /// </summary>
         /// <param name="typeInfo">type_info of the component type. Must be a valid pointer.</param>
         /// <param name="size">Size of the component in bytes. Must be greater than 0.</param>
         /// <param name="align">Alignment of the component in bytes. Must be greater than 0.</param>
+        /// <param name="lifecycle">Kernels managing the lifetime of instances. Defaults to a trivially copyable and destructible type.</param>
         /// <param name="owner">Owner of this component type.</param>
-        ComponentTypeT(const type_info* typeInfo, Size_t size, Size_t align, ComponentOwner owner)
+        ComponentTypeT(const type_info* typeInfo, Size_t size, Size_t align, ComponentOwner owner, const ComponentLifecycle_t& lifecycle = ComponentLifecycle_t())
             : TypeInfo(typeInfo)
+            , Id(ComponentRegistry::Get().Register(typeInfo))
             , Size(size)
             , Align(align)
             , Owner(owner) 
+            , Lifecycle(lifecycle)
+            , SplitBlockNodes(0)
+            , SplitFieldSize(0)
         {
             assert_pnc(TypeInfo != nullptr);
             assert_pnc(Size > 0);
@@ -70,12 +100,23 @@ namespace PNC
         template<typename T>
         ComponentTypeT(const T* _nullptr, ComponentOwner owner)
             : TypeInfo(&typeid(T))
+            , Id(ComponentRegistry::GetId<T>())
             , Size(sizeof(T))
             , Align(alignof(T))
             , Owner(owner)
+            , Lifecycle(ComponentLifecycle_t::template Make<T>())
+            , SplitBlockNodes(0)
+            , SplitFieldSize(0)
         {
             assert_pnc(_nullptr == nullptr);
             assert_pnc(owner >= ComponentOwner__Begin && owner < ComponentOwner__End);
+            if constexpr (requires { T::SplitBlockNodes; })
+            {
+                static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>, "A SplitNodeComponent must be trivially copyable and destructible.");
+                assert_pnc(owner == ComponentOwner_Node);
+                SplitBlockNodes = (Size_t)T::SplitBlockNodes;
+                SplitFieldSize = (Size_t)sizeof(typename T::SplitField_t);
+            }
         }
 
         /// <summary>
@@ -90,6 +131,53 @@ namespace PNC
             return FMemory::Malloc(Size * count, Align);
         }
 
+        /// <summary>
+        /// Allocate enough memory to fit all component instance for the given capacity of a chunk using an allocator policy.
+        /// </summary>
+        /// <param name="allocator">Allocator policy, see ChunkHeapAllocator.</param>
+        /// <param name="chunkStructure">Structure of the chunk the memory is for.</param>
+        /// <param name="nodeCapacity">How many instances of the component is required to be allocated</param>
+        /// <param name="chunkCapacity">How many sub-chunks in the array of data</param>
+        /// <param name="alignment">Alignment in bytes of the memory, 0 to use the component's alignment.</param>
+        /// <returns>Pointer to the allocated memory. Must be freed by calling Deallocate with the same allocator and alignment.</returns>
+        template<typename TAllocator, typename TChunkStructure>
+        void* Allocate(TAllocator& allocator, const TChunkStructure* chunkStructure, Size_t nodeCapacity, Size_t chunkCapacity = 1, uint32 alignment = 0)const
+        {
+            SIZE_T size = GetAllocationSize(nodeCapacity, chunkCapacity);
+            chunkStructure->GetStats().AddBytes(size);
+            return allocator.Allocate(chunkStructure, nodeCapacity, size, alignment != 0 ? alignment : (uint32)Align);
+        }
+
+        /// <summary>
+        /// Get the size in bytes required to fit all component instance for the given capacity of a chunk.
+        /// </summary>
+        /// <param name="nodeCapacity">How many instances of the component is required to be allocated</param>
+        /// <param name="chunkCapacity">How many sub-chunks in the array of data</param>
+        SIZE_T GetAllocationSize(Size_t nodeCapacity, Size_t chunkCapacity = 1)const
+        {
+            return (SIZE_T)Size * GetNodeDataIndex(nodeCapacity, chunkCapacity);
+        }
+
+        /// <summary>
+        /// Get the size in bytes required to fit all component instance for capacities beyond the range of Size_t,
+        /// such as the address space reserved for a Chunk Array's maximum capacity.
+        /// </summary>
+        /// <param name="nodeCapacity">How many instances of the component is required to be allocated</param>
+        /// <param name="chunkCapacity">How many sub-chunks in the array of data</param>
+        SIZE_T GetAllocationSize(SIZE_T nodeCapacity, SIZE_T chunkCapacity)const
+        {
+            switch (Owner)
+            {
+            case ComponentOwner_Node:
+                return (SIZE_T)Size * nodeCapacity;
+            case ComponentOwner_Chunk:
+                return (SIZE_T)Size * chunkCapacity;
+            default:
+                checkNoEntry();
+                return 0;
+            }
+        }
+
         /// <summary>
         /// Allocate enough memory to fit all component instance for the given capacity of a chunk and copy data into it.
         /// </summary>
@@ -101,8 +189,7 @@ namespace PNC
         {
             auto chunkCapacityCount = GetNodeDataIndex(nodeCapacity, chunkCapacity);
             auto ptr = FMemory::Malloc(Size * chunkCapacityCount, Align);
-            auto chunkSizeCount = GetNodeDataIndex(nodeCount, chunkCapacity);
-            Copy(ptr, from, Size * chunkSizeCount);
+            Copy(ptr, from, nodeCount, chunkCapacity);
             return ptr;
         }
 
@@ -118,28 +205,239 @@ namespace PNC
         }
 
         /// <summary>
-        /// Copy component data from one chunk of memory to another.
+        /// Deallocate component memory previously allocated with an allocator policy.
+        /// </summary>
+        /// <param name="allocator">Allocator policy used to allocate the memory.</param>
+        /// <param name="chunkStructure">Structure of the chunk the memory is for.</param>
+        /// <param name="ptr">pointer from a previous call to Allocate with the same allocator</param>
+        /// <param name="nodeCapacity"></param>
+        /// <param name="chunkCapacity">How many sub-chunks in the array of data</param>
+        /// <param name="alignment">Alignment given to Allocate.</param>
+        template<typename TAllocator, typename TChunkStructure>
+        void Deallocate(TAllocator& allocator, const TChunkStructure* chunkStructure, void* ptr, Size_t nodeCapacity, Size_t chunkCapacity = 1, uint32 alignment = 0)const
+        {
+            SIZE_T size = GetAllocationSize(nodeCapacity, chunkCapacity);
+            chunkStructure->GetStats().RemoveBytes(size);
+            allocator.Deallocate(chunkStructure, nodeCapacity, ptr, size, alignment != 0 ? alignment : (uint32)Align);
+        }
+
+        /// <summary>
+        /// If instances can be created, copied, moved and destroyed without running any code.
+        /// </summary>
+        bool IsTrivial()const { return Lifecycle.IsTrivial(); }
+
+        /// <summary>
+        /// If the column is split by field in blocks of SplitBlockNodes Nodes.
+        /// </summary>
+        bool IsSplit()const { return SplitBlockNodes != 0; }
+
+        /// <summary>
+        /// Copy construct component data from one chunk of memory to another, uninitialized, one.
         /// </summary>
         /// <param name="to">destination memory</param>
         /// <param name="from">source memory</param>
         /// <param name="nodeCount">How many component instances to copy</param>
-        void Copy(void* to, void* from, Size_t nodeCount, Size_t chunkCapacity = 1)const
+        void Copy(void* to, const void* from, Size_t nodeCount, Size_t chunkCapacity = 1)const
         {
-            auto count = GetNodeDataIndex(nodeCount, chunkCapacity);
-            memcpy_s(to, count * Size, from, count * Size);
+            auto count = GetStoredCount(nodeCount, chunkCapacity);
+            if (Lifecycle.CopyConstruct != nullptr)
+                Lifecycle.CopyConstruct(to, from, count);
+            else
+                memcpy_s(to, count * Size, from, count * Size);
+        }
+
+        /// <summary>
+        /// Move component data from one chunk of memory to another, uninitialized, one.
+        /// The source instances are destroyed.
+        /// </summary>
+        /// <param name="to">destination memory</param>
+        /// <param name="from">source memory</param>
+        /// <param name="nodeCount">How many component instances to move</param>
+        void Relocate(void* to, void* from, Size_t nodeCount, Size_t chunkCapacity = 1)const
+        {
+            auto count = GetStoredCount(nodeCount, chunkCapacity);
+            if (Lifecycle.Relocate != nullptr)
+                Lifecycle.Relocate(to, from, count);
+            else
+                memcpy_s(to, count * Size, from, count * Size);
         }
 
-        void* SubChunk(void* ptr, Size_t count)const
+        /// <summary>
+        /// Default construct the instances of a range of nodes.
+        /// The fields of a default constructed instance are scattered to the nodes of a split component.
+        /// Does nothing for ComponentOwner_Chunk components, see ConstructChunk.
+        /// </summary>
+        /// <param name="data">component memory array</param>
+        /// <param name="nodeIndex">first node to construct</param>
+        /// <param name="count">How many nodes to construct</param>
+        void ConstructNodes(void* data, Size_t nodeIndex, Size_t count)const
+        {
+            if (Owner != ComponentOwner_Node || Lifecycle.Construct == nullptr)
+                return;
+            if (!IsSplit())
+            {
+                Lifecycle.Construct(Forward(data, nodeIndex), count);
+                return;
+            }
+            // Split components are trivially destructible, the default instance is simply dropped.
+            alignas(16) uint8 stackInstance[256];
+            bool bHeap = Size > sizeof(stackInstance) || Align > 16;
+            void* instance = bHeap ? FMemory::Malloc(Size, Align) : stackInstance;
+            Lifecycle.Construct(instance, 1);
+            for (Size_t i = nodeIndex; i < nodeIndex + count; ++i)
+                for (Size_t field = 0; field < Size / SplitFieldSize; ++field)
+                    FMemory::Memcpy(GetSplitField(data, i, field), (uint8*)instance + (SIZE_T)field * SplitFieldSize, SplitFieldSize);
+            if (bHeap)
+                FMemory::Free(instance);
+        }
+
+        /// <summary>
+        /// Destroy the instances of a range of nodes.
+        /// Does nothing for ComponentOwner_Chunk components, see DestroyChunk.
+        /// </summary>
+        /// <param name="data">component memory array</param>
+        /// <param name="nodeIndex">first node to destroy</param>
+        /// <param name="count">How many nodes to destroy</param>
+        void DestroyNodes(void* data, Size_t nodeIndex, Size_t count)const
+        {
+            if (Owner == ComponentOwner_Node && Lifecycle.Destroy != nullptr)
+                Lifecycle.Destroy(Forward(data, nodeIndex), count);
+        }
+
+        /// <summary>
+        /// Default construct the instance of a ComponentOwner_Chunk component. Does nothing for ComponentOwner_Node components.
+        /// </summary>
+        void ConstructChunk(void* data)const
+        {
+            if (Owner == ComponentOwner_Chunk && Lifecycle.Construct != nullptr)
+                Lifecycle.Construct(data, 1);
+        }
+
+        /// <summary>
+        /// Destroy the instance of a ComponentOwner_Chunk component. Does nothing for ComponentOwner_Node components.
+        /// </summary>
+        void DestroyChunk(void* data)const
+        {
+            if (Owner == ComponentOwner_Chunk && Lifecycle.Destroy != nullptr)
+                Lifecycle.Destroy(data, 1);
+        }
+
+        /// <summary>
+        /// Destroy the instances of a list of nodes.
+        /// Does nothing for ComponentOwner_Chunk components as they are shared by all nodes.
+        /// </summary>
+        /// <param name="data">component memory array</param>
+        /// <param name="nodeIndices">node index of each instance to destroy</param>
+        /// <param name="count">How many instances to destroy</param>
+        void DestroyNodes(void* data, const Size_t* nodeIndices, Size_t count)const
+        {
+            if (Owner == ComponentOwner_Node && Lifecycle.DestroyIndexed != nullptr)
+                Lifecycle.DestroyIndexed(data, nodeIndices, count);
+        }
+
+        /// <summary>
+        /// Move component instances between nodes of the same component memory array.
+        /// Destination slots must be uninitialized, source slots are left uninitialized.
+        /// Does nothing for ComponentOwner_Chunk components as they are shared by all nodes.
+        /// </summary>
+        /// <param name="data">component memory array</param>
+        /// <param name="from">node index of each instance to move</param>
+        /// <param name="to">node index each instance moves to</param>
+        /// <param name="count">How many instances to move</param>
+        void MoveNodes(void* data, const Size_t* from, const Size_t* to, Size_t count)const
+        {
+            if (Owner != ComponentOwner_Node)
+                return;
+            if (Lifecycle.RelocateIndexed != nullptr)
+            {
+                Lifecycle.RelocateIndexed(data, from, to, count);
+                return;
+            }
+            if (IsSplit())
+            {
+                for (Size_t i = 0; i < count; ++i)
+                    for (Size_t field = 0; field < Size / SplitFieldSize; ++field)
+                        FMemory::Memcpy(GetSplitField(data, to[i], field), GetSplitField(data, from[i], field), SplitFieldSize);
+                return;
+            }
+            uint8* bytes = (uint8*)data;
+            for (Size_t i = 0; i < count; ++i)
+                FMemory::Memcpy(bytes + (SIZE_T)to[i] * Size, bytes + (SIZE_T)from[i] * Size, Size);
+        }
+
+        /// <summary>
+        /// Move the instance of a node out of a component memory array into a single instance buffer.
+        /// The node's slot is left uninitialized. Does nothing for ComponentOwner_Chunk components.
+        /// </summary>
+        /// <param name="data">component memory array</param>
+        /// <param name="nodeIndex">node to move out</param>
+        /// <param name="buffer">uninitialized memory of Size bytes aligned to Align</param>
+        void ParkNode(void* data, Size_t nodeIndex, void* buffer)const
+        {
+            if (Owner != ComponentOwner_Node)
+                return;
+            if (!IsSplit())
+            {
+                Relocate(buffer, Forward(data, nodeIndex), 1);
+                return;
+            }
+            for (Size_t field = 0; field < Size / SplitFieldSize; ++field)
+                FMemory::Memcpy((uint8*)buffer + (SIZE_T)field * SplitFieldSize, GetSplitField(data, nodeIndex, field), SplitFieldSize);
+        }
+
+        /// <summary>
+        /// Move an instance parked with ParkNode back into the uninitialized slot of a node.
+        /// </summary>
+        /// <param name="data">component memory array</param>
+        /// <param name="nodeIndex">node to move the instance to</param>
+        /// <param name="buffer">instance parked with ParkNode, left uninitialized</param>
+        void UnparkNode(void* data, Size_t nodeIndex, void* buffer)const
+        {
+            if (Owner != ComponentOwner_Node)
+                return;
+            if (!IsSplit())
+            {
+                Relocate(Forward(data, nodeIndex), buffer, 1);
+                return;
+            }
+            for (Size_t field = 0; field < Size / SplitFieldSize; ++field)
+                FMemory::Memcpy(GetSplitField(data, nodeIndex, field), (uint8*)buffer + (SIZE_T)field * SplitFieldSize, SplitFieldSize);
+        }
+
+        /// <summary>
+        /// Get the address of a field of a node in the column of a split component.
+        /// </summary>
+        /// <param name="data">component memory array</param>
+        /// <param name="nodeIndex">index of the node in the column</param>
+        /// <param name="field">index of the field in the component</param>
+        void* GetSplitField(void* data, Size_t nodeIndex, Size_t field)const
+        {
+            assert_pnc(IsSplit());
+            SIZE_T block = (SIZE_T)nodeIndex / SplitBlockNodes;
+            SIZE_T lane = (SIZE_T)nodeIndex % SplitBlockNodes;
+            return (uint8*)data + block * SplitBlockNodes * Size + ((SIZE_T)field * SplitBlockNodes + lane) * SplitFieldSize;
+        }
+
+        /// <summary>
+        /// Get where a sub range of a chunk starting at a given node begins in a component memory array.
+        /// ComponentOwner_Node components are offset to the node, ComponentOwner_Chunk components are shared by the sub range.
+        /// </summary>
+        /// <param name="ptr">component memory array of the chunk</param>
+        /// <param name="nodeIndex">first node of the sub range</param>
+        /// <returns>component memory array of the sub range</returns>
+        void* SubChunk(void* ptr, Size_t nodeIndex)const
         {
             switch (Owner)
             {
             case ComponentOwner_Node:
-                return ptr + count * Size;
+                // A split column can only be cut between blocks.
+                assert_pnc(!IsSplit() || nodeIndex % SplitBlockNodes == 0);
+                return Forward(ptr, nodeIndex);
             case ComponentOwner_Chunk:
-                return ptr + Size;
+                return ptr;
             default:
                 checkNoEntry();
-                return -1;
+                return nullptr;
             }
         }
 
@@ -151,6 +449,15 @@ namespace PNC
         {
             return (uint8*)ptr - count * Size;
         }
+        /// <summary>
+        /// Number of instances stored for a number of nodes, which is rounded up to whole blocks for split components.
+        /// </summary>
+        Size_t GetStoredCount(Size_t nodeCount, Size_t chunkCapacity = 1)const
+        {
+            auto count = GetNodeDataIndex(nodeCount, chunkCapacity);
+            return IsSplit() ? (count + SplitBlockNodes - 1) / SplitBlockNodes * SplitBlockNodes : count;
+        }
+
         /// <summary>
         /// Figure out the index into an array of this component type where a node's component instance is stored.
         /// </summary>
@@ -4,6 +4,7 @@
 #pragma once
 #include "common.h"
 #include "ComponentType.h"
+#include "ComponentSignature.h"
 
 namespace PNC
 {
@@ -21,7 +22,21 @@ namespace PNC
 
     private:
         std::vector<const ComponentType_t*> ComponentTypes;
-        std::unordered_map<const type_info*, Size_t> TypeToComponentTypeIndexInChunk;
+
+        /// <summary>
+        /// Index in the set of each ComponentId from MinComponentId, or -1 for ids not in the set.
+        /// </summary>
+        std::vector<Size_t> IdToComponentTypeIndexInChunk;
+
+        /// <summary>
+        /// Lowest ComponentId in the set. The flat table only spans the ids of the set.
+        /// </summary>
+        ComponentId MinComponentId;
+
+        /// <summary>
+        /// Bitset of the ComponentIds in the set.
+        /// </summary>
+        ComponentSignature Signature;
 
     public:
         /// <summary>
@@ -29,6 +44,11 @@ namespace PNC
         /// </summary>
         Size_t GetSize()const { return ComponentTypes.size(); }
 
+        /// <summary>
+        /// Get the bitset of the ComponentIds in the set.
+        /// </summary>
+        const ComponentSignature& GetSignature()const { return Signature; }
+
         /// <summary>
         /// Get the component type at an index less than the set's size.
         /// </summary>
@@ -48,28 +68,66 @@ namespace PNC
             UpdateMap();
         }
 
+        /// <summary>
+        /// Create a ComponentTypeSet made of all the component types of another set followed by a list of ComponentType
+        /// </summary>
+        /// <param name="base">Set whose component types come first, at the same indices.</param>
+        /// <param name="aTypes">Component types added after the ones of the base set.</param>
+        ComponentTypeSetT(const Self_t& base, const std::initializer_list<const ComponentType_t*>& aTypes)
+            :ComponentTypes(base.ComponentTypes)
+        {
+            ComponentTypes.insert(ComponentTypes.end(), aTypes.begin(), aTypes.end());
+            UpdateMap();
+        }
+
     public:
+        /// <summary>
+        /// Get the index of a component type in the set from its ComponentId with a single table load.
+        /// Will return -1 if the component type is not present in the set.
+        /// </summary>
+        /// <param name="id">Id of the component type. ex. ComponentRegistry::GetId<MyComponent>()</param>
+        /// <returns>return index of the component type in the set or -1 if not found.</returns>
+        Size_t GetComponentTypeIndexInChunk(ComponentId id)const
+        {
+            // Ids below MinComponentId wrap around to large unsigned values and fail the bound check.
+            SIZE_T offset = (SIZE_T)(uint32)(id - MinComponentId);
+            if (offset >= IdToComponentTypeIndexInChunk.size())
+                return -1;
+            return IdToComponentTypeIndexInChunk[offset];
+        }
+
         /// <summary>
         /// Get the index of a component type_info in the set.
         /// Will return -1 if the component type is not present in the set.
+        /// This requires a ComponentRegistry hash map lookup, prefer the ComponentId overload.
         /// </summary>
         /// <param name="type">type_info of the component type. ex. &typeid(MyComponent)</param>
         /// <returns>return index of the component type in the set or -1 if not found.</returns>
         Size_t GetComponentTypeIndexInChunk(const type_info* type)const 
         {
-            auto i = TypeToComponentTypeIndexInChunk.find(type);
-            if (i == TypeToComponentTypeIndexInChunk.end())
-                return -1;
-            return i->second;
+            return GetComponentTypeIndexInChunk(ComponentRegistry::Get().Find(type));
         }
 
     private:
         void UpdateMap() 
         {
-            TypeToComponentTypeIndexInChunk.clear();
+            IdToComponentTypeIndexInChunk.clear();
+            Signature.Reset();
+            MinComponentId = 0;
+            if (ComponentTypes.empty())
+                return;
+            ComponentId maxComponentId = ComponentTypes[0]->Id;
+            MinComponentId = ComponentTypes[0]->Id;
+            for (const ComponentType_t* componentType : ComponentTypes)
+            {
+                MinComponentId = FMath::Min(MinComponentId, componentType->Id);
+                maxComponentId = FMath::Max(maxComponentId, componentType->Id);
+            }
+            IdToComponentTypeIndexInChunk.resize(maxComponentId - MinComponentId + 1, -1);
             for (int i = 0; i < ComponentTypes.size(); ++i) 
             {
-                TypeToComponentTypeIndexInChunk[ComponentTypes[i]->TypeInfo] = i;
+                IdToComponentTypeIndexInChunk[ComponentTypes[i]->Id - MinComponentId] = i;
+                Signature.Add(ComponentTypes[i]->Id);
             }
         }
     };
@@ -4,6 +4,7 @@
 #pragma once
 #include "common.h"
 #include "KTreePointer.h"
+#include "LinearChunkTree.h"
 
 namespace PNC
 {
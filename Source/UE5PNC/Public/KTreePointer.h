@@ -9,6 +9,9 @@
 
 namespace PNC
 {
+    template<typename TChunkStructure>
+    struct LinearChunkTreeT;
+
     /// <summary>
     /// A KTreePointer is a KindPointer that is part of a Tree of Chunks
     /// A KTreePointer is non-copyable as it may be pointed to by other KTreePointers
@@ -25,8 +28,20 @@ namespace PNC
 
     protected:
         using ChunkTreeNode_t = ChunkTreeNodeT<Self_t>;
+        using LinearChunkTree_t = LinearChunkTreeT<ChunkStructure_t>;
+        friend LinearChunkTree_t;
         ChunkTreeNode_t Tree;
 
+        /// <summary>
+        /// The linearized tree this KTreePointer is the root of, notified of every edit below it. Null if none.
+        /// </summary>
+        LinearChunkTree_t* LinearTree = nullptr;
+
+        /// <summary>
+        /// Index of this KTreePointer in the LinearChunkTree of its root, valid while the LinearChunkTree is up to date.
+        /// </summary>
+        Size_t LinearIndex = -1;
+
     protected:
         KTreePointerT(ChunkKind kind)
             :Base_t(kind)
@@ -64,15 +79,32 @@ namespace PNC
         /// </summary>
         Self_t* GetNextSiblingChunk()const { return Tree.NextSibling; }
 
+        /// <summary>
+        /// Get the root of the tree by following the parents.
+        /// </summary>
+        Self_t* GetRootChunk()
+        {
+            Self_t* root = this;
+            while (root->Tree.Parent != nullptr)
+                root = root->Tree.Parent;
+            return root;
+        }
+
         /// <summary>
         /// Extract this KTreePointerT from any Tree.
+        /// Its subtree leaves the LinearChunkTree of the previous root, if any, see NotifyExtracted.
         /// </summary>
         void Extract()
         {
+            Self_t* parent = Tree.Parent;
+            if (parent != nullptr && parent->Tree.FirstChild == this)
+                parent->Tree.FirstChild = Tree.NextSibling == this ? nullptr : Tree.NextSibling;
             Tree.PreviousSibling->Tree.NextSibling = Tree.NextSibling;
             Tree.NextSibling->Tree.PreviousSibling = Tree.PreviousSibling;
             Tree.PreviousSibling = nullptr;
             Tree.NextSibling = nullptr;
+            Tree.Parent = nullptr;
+            NotifyExtracted(parent);
         }
 
         /// <summary>
@@ -111,7 +143,8 @@ namespace PNC
         /// <param name="sibling">KTreePointer to move.</param>
         void MoveToNextSibling(Self_t* sibling)
         {
-            Tree.NextSibling->MoveToNextSibling(sibling);
+            sibling->Extract();
+            InsertNextSibling(sibling);
         }
 
         /// <summary>
@@ -133,6 +166,7 @@ namespace PNC
                 Tree.FirstChild->InsertPreviousSibling(child);
                 Tree.FirstChild = child;
             }
+            NotifyChildrenEdited(this);
         }
 
         /// <summary>
@@ -153,6 +187,7 @@ namespace PNC
             {
                 Tree.FirstChild->InsertPreviousSibling(child);
             }
+            NotifyChildrenEdited(this);
         }
 
         /// <summary>
@@ -166,7 +201,9 @@ namespace PNC
             last->Tree.NextSibling = sibling;
             sibling->Tree.PreviousSibling = last;
             sibling->Tree.NextSibling = this;
+            sibling->Tree.Parent = Tree.Parent;
             Tree.PreviousSibling = sibling;
+            NotifyChildrenEdited(Tree.Parent);
         }
 
         /// <summary>
@@ -177,5 +214,33 @@ namespace PNC
         {
             Tree.NextSibling->InsertPreviousSibling(sibling);
         }
+
+    protected:
+        /// <summary>
+        /// Tell the LinearChunkTree holding a KTreePointer, if any, that its children changed.
+        /// </summary>
+        /// <param name="parent">KTreePointer whose children changed, may be null.</param>
+        static void NotifyChildrenEdited(Self_t* parent)
+        {
+            if (parent == nullptr)
+                return;
+            Self_t* root = parent->GetRootChunk();
+            if (root->LinearTree != nullptr)
+                root->LinearTree->MarkChildrenEdited(parent);
+        }
+
+        /// <summary>
+        /// Tell the LinearChunkTree holding the previous parent of this extracted KTreePointer, if any, that its subtree left the tree.
+        /// The tree forgets the KTreePointers of the subtree so it never reaches them after they are moved or deleted.
+        /// </summary>
+        /// <param name="parent">Previous parent, may be null.</param>
+        void NotifyExtracted(Self_t* parent)
+        {
+            if (parent == nullptr)
+                return;
+            Self_t* root = parent->GetRootChunk();
+            if (root->LinearTree != nullptr)
+                root->LinearTree->MarkSubtreeExtracted(this, parent);
+        }
     };
 }
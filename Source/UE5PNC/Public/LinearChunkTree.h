@@ -0,0 +1,316 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "KTreePointer.h"
+#include <algorithm>
+
+namespace PNC
+{
+    /// <summary>
+    /// A LinearChunkTree stores a tree of KTreePointers in one array in depth-first order.
+    /// The subtree of the KTreePointer at index i is the range [i, GetSubtreeEnd(i)), parents come before their children,
+    /// so traversals walk the array in order and ancestor checks compare two indices.
+    /// Edits made with the KTreePointer's Insert, Move and Extract functions below the root are recorded,
+    /// and Update re-linearizes only the subtrees whose children changed.
+    /// The KTreePointers are not owned and must outlive the LinearChunkTree or be extracted from its root, which must stay a root.
+    /// </summary>
+    /// <typeparam name="TChunkStructure">Structure of the Chunk's Component data.</typeparam>
+    template<typename TChunkStructure>
+    struct LinearChunkTreeT
+    {
+    public:
+        using Self_t = LinearChunkTreeT<TChunkStructure>;
+        using ChunkStructure_t = TChunkStructure;
+        using Size_t = typename ChunkStructure_t::Size_t;
+        using KTreePointer_t = KTreePointerT<ChunkStructure_t>;
+
+        /// <summary>
+        /// A KTreePointer of the tree in depth-first order.
+        /// </summary>
+        struct Entry
+        {
+            /// <summary>
+            /// The KTreePointer.
+            /// </summary>
+            KTreePointer_t* Chunk;
+
+            /// <summary>
+            /// Index of the parent's entry, or -1 for the root.
+            /// </summary>
+            Size_t Parent;
+
+            /// <summary>
+            /// Index one past the last entry of the subtree.
+            /// </summary>
+            Size_t SubtreeEnd;
+
+            /// <summary>
+            /// Number of ancestors, 0 for the root.
+            /// </summary>
+            Size_t Depth;
+        };
+
+    protected:
+        KTreePointer_t* Root;
+        std::vector<Entry> Entries;
+
+        /// <summary>
+        /// KTreePointers whose children changed since the last Update.
+        /// </summary>
+        std::vector<KTreePointer_t*> EditedParents;
+
+    public:
+        LinearChunkTreeT()
+            : Root(nullptr)
+        {
+        }
+
+        /// <param name="root">Root of the tree to linearize, it must not have a parent.</param>
+        LinearChunkTreeT(KTreePointer_t* root)
+            : Root(nullptr)
+        {
+            Reset(root);
+        }
+
+        ~LinearChunkTreeT()
+        {
+            Reset(nullptr);
+        }
+
+        LinearChunkTreeT(const LinearChunkTreeT&) = delete;
+        LinearChunkTreeT& operator=(const LinearChunkTreeT&) = delete;
+
+    public:
+        /// <summary>
+        /// Linearize another tree, or none if null.
+        /// </summary>
+        /// <param name="root">Root of the tree to linearize, it must not have a parent nor be the root of another LinearChunkTree.</param>
+        void Reset(KTreePointer_t* root)
+        {
+            if (Root != nullptr)
+                Root->LinearTree = nullptr;
+            Root = root;
+            Entries.clear();
+            EditedParents.clear();
+            if (Root == nullptr)
+                return;
+            assert_pnc(Root->Tree.Parent == nullptr);
+            assert_pnc(Root->LinearTree == nullptr);
+            Root->LinearTree = this;
+            Linearize(Root, -1, 0, Entries);
+            for (Size_t i = 0; i < GetSize(); ++i)
+                Entries[i].Chunk->LinearIndex = i;
+        }
+
+        /// <summary>
+        /// If edits were made to the tree since the last Update.
+        /// </summary>
+        bool IsDirty()const { return !EditedParents.empty(); }
+
+        /// <summary>
+        /// Re-linearize the subtrees whose children changed since the last Update.
+        /// Each edited subtree is rebuilt in place, then the following entries are shifted by its change of size.
+        /// Only KTreePointers reachable from the root are visited, extracted subtrees are forgotten by MarkSubtreeExtracted.
+        /// </summary>
+        void Update()
+        {
+            if (EditedParents.empty())
+                return;
+            assert_pnc(Root->Tree.Parent == nullptr);
+            // Only rebuild the edited KTreePointers still in the tree without an edited ancestor.
+            std::sort(EditedParents.begin(), EditedParents.end());
+            EditedParents.erase(std::unique(EditedParents.begin(), EditedParents.end()), EditedParents.end());
+            std::vector<KTreePointer_t*> rebuilds;
+            for (KTreePointer_t* parent : EditedParents)
+            {
+                bool rebuild = true;
+                KTreePointer_t* node = parent;
+                for (; node->Tree.Parent != nullptr; node = node->Tree.Parent)
+                    rebuild &= !std::binary_search(EditedParents.begin(), EditedParents.end(), node->Tree.Parent);
+                if (rebuild && node == Root)
+                    rebuilds.push_back(parent);
+            }
+            EditedParents.clear();
+            // Back to front so the indices of the remaining subtrees to rebuild stay valid.
+            std::sort(rebuilds.begin(), rebuilds.end(), [](const KTreePointer_t* a, const KTreePointer_t* b) { return a->LinearIndex > b->LinearIndex; });
+            std::vector<Entry> subtree;
+            for (KTreePointer_t* parent : rebuilds)
+                Relinearize(parent, subtree);
+        }
+
+        /// <summary>
+        /// Get the root of the tree.
+        /// </summary>
+        KTreePointer_t* GetRoot()const { return Root; }
+
+        /// <summary>
+        /// Number of KTreePointers in the tree.
+        /// </summary>
+        Size_t GetSize()const { return (Size_t)Entries.size(); }
+
+        const Entry& operator[](Size_t index)const { return Entries[index]; }
+        const Entry* begin()const { return Entries.data(); }
+        const Entry* end()const { return Entries.data() + Entries.size(); }
+
+        /// <summary>
+        /// Get the index of a KTreePointer of the tree.
+        /// </summary>
+        Size_t GetIndex(const KTreePointer_t* chunk)const
+        {
+            assert_pnc(!IsDirty());
+            assert_pnc(chunk->LinearIndex >= 0 && chunk->LinearIndex < GetSize() && Entries[chunk->LinearIndex].Chunk == chunk);
+            return chunk->LinearIndex;
+        }
+
+        /// <summary>
+        /// Get the index one past the last entry of the subtree of an entry.
+        /// The subtree of the entry at index i is the range [i, GetSubtreeEnd(i)).
+        /// </summary>
+        Size_t GetSubtreeEnd(Size_t index)const { return Entries[index].SubtreeEnd; }
+
+        /// <summary>
+        /// Number of KTreePointers in the subtree of an entry, including itself.
+        /// </summary>
+        Size_t GetSubtreeSize(Size_t index)const { return Entries[index].SubtreeEnd - index; }
+
+        /// <summary>
+        /// If the entry at index ancestor is a strict ancestor of the entry at index descendant.
+        /// </summary>
+        bool IsAncestor(Size_t ancestor, Size_t descendant)const
+        {
+            return ancestor < descendant && descendant < Entries[ancestor].SubtreeEnd;
+        }
+
+        /// <summary>
+        /// If a KTreePointer is a strict ancestor of another, both part of the tree.
+        /// </summary>
+        bool IsAncestor(const KTreePointer_t* ancestor, const KTreePointer_t* descendant)const
+        {
+            return IsAncestor(GetIndex(ancestor), GetIndex(descendant));
+        }
+
+        /// <summary>
+        /// Call func(index, entry) for each entry of the subtree of an entry, in depth-first order.
+        /// </summary>
+        template<typename TFunc>
+        void ForEachInSubtree(Size_t index, TFunc&& func)const
+        {
+            for (Size_t i = index; i < Entries[index].SubtreeEnd; ++i)
+                func(i, Entries[i]);
+        }
+
+        /// <summary>
+        /// Call func(index, entry) for each direct child of an entry, in sibling order.
+        /// </summary>
+        template<typename TFunc>
+        void ForEachChild(Size_t index, TFunc&& func)const
+        {
+            for (Size_t i = index + 1; i < Entries[index].SubtreeEnd; i = Entries[i].SubtreeEnd)
+                func(i, Entries[i]);
+        }
+
+        /// <summary>
+        /// Append the subtree of a KTreePointer in depth-first order.
+        /// Parent and SubtreeEnd indices of the appended entries are indices in out.
+        /// </summary>
+        /// <param name="chunk">Root of the subtree.</param>
+        /// <param name="parent">Parent index of the subtree's root entry.</param>
+        /// <param name="depth">Depth of the subtree's root entry.</param>
+        /// <param name="out">Receives the entries.</param>
+        static void Linearize(KTreePointer_t* chunk, Size_t parent, Size_t depth, std::vector<Entry>& out)
+        {
+            Size_t index = (Size_t)out.size();
+            out.push_back(Entry{ chunk, parent, 0, depth });
+            KTreePointer_t* firstChild = chunk->Tree.FirstChild;
+            if (firstChild != nullptr)
+            {
+                KTreePointer_t* child = firstChild;
+                do
+                {
+                    Linearize(child, index, depth + 1, out);
+                    child = child->Tree.NextSibling;
+                } while (child != firstChild);
+            }
+            out[index].SubtreeEnd = (Size_t)out.size();
+        }
+
+    protected:
+        friend KTreePointer_t;
+
+        /// <summary>
+        /// Called by the KTreePointers of the tree when the children of one of them changed.
+        /// </summary>
+        void MarkChildrenEdited(KTreePointer_t* parent)
+        {
+            EditedParents.push_back(parent);
+        }
+
+        /// <summary>
+        /// Called by a KTreePointer of the tree when it is extracted with its subtree.
+        /// The KTreePointers of the subtree are no longer tracked, they may be deleted or linearized by another tree before the next Update.
+        /// </summary>
+        /// <param name="chunk">Extracted KTreePointer.</param>
+        /// <param name="parent">Its previous parent, still in the tree.</param>
+        void MarkSubtreeExtracted(KTreePointer_t* chunk, KTreePointer_t* parent)
+        {
+            std::vector<Entry> subtree;
+            Linearize(chunk, -1, 0, subtree);
+            std::vector<KTreePointer_t*> extracted;
+            extracted.reserve(subtree.size());
+            for (const Entry& entry : subtree)
+            {
+                entry.Chunk->LinearIndex = -1;
+                extracted.push_back(entry.Chunk);
+            }
+            std::sort(extracted.begin(), extracted.end());
+            EditedParents.erase(std::remove_if(EditedParents.begin(), EditedParents.end(), [&](KTreePointer_t* edited)
+                {
+                    return std::binary_search(extracted.begin(), extracted.end(), edited);
+                }), EditedParents.end());
+            MarkChildrenEdited(parent);
+        }
+
+        /// <summary>
+        /// Rebuild the subtree of a KTreePointer whose entry is up to date and splice it in place of the old one.
+        /// </summary>
+        void Relinearize(KTreePointer_t* chunk, std::vector<Entry>& subtree)
+        {
+            Size_t begin = chunk->LinearIndex;
+            assert_pnc(Entries[begin].Chunk == chunk);
+            Size_t oldEnd = Entries[begin].SubtreeEnd;
+            Size_t parent = Entries[begin].Parent;
+            subtree.clear();
+            Linearize(chunk, parent, Entries[begin].Depth, subtree);
+            Size_t newEnd = begin + (Size_t)subtree.size();
+            Size_t delta = newEnd - oldEnd;
+            if (delta > 0)
+                Entries.insert(Entries.begin() + oldEnd, delta, Entry());
+            else if (delta < 0)
+                Entries.erase(Entries.begin() + newEnd, Entries.begin() + oldEnd);
+            // The subtree was linearized from index 0, offset it to its place.
+            for (Size_t i = 0; i < (Size_t)subtree.size(); ++i)
+            {
+                Entry& entry = subtree[i];
+                if (i > 0)
+                    entry.Parent += begin;
+                entry.SubtreeEnd += begin;
+                entry.Chunk->LinearIndex = begin + i;
+                Entries[begin + i] = entry;
+            }
+            if (delta == 0)
+                return;
+            for (Size_t i = newEnd; i < GetSize(); ++i)
+            {
+                Entry& entry = Entries[i];
+                entry.SubtreeEnd += delta;
+                if (entry.Parent >= oldEnd)
+                    entry.Parent += delta;
+                entry.Chunk->LinearIndex = i;
+            }
+            for (Size_t ancestor = parent; ancestor != -1; ancestor = Entries[ancestor].Parent)
+                Entries[ancestor].SubtreeEnd += delta;
+        }
+    };
+}
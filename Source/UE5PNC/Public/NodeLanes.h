@@ -0,0 +1,444 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "NodeSelection.h"
+#include "SplitColumn.h"
+#include <type_traits>
+
+// Width in bytes of the widest vector register of the target ISA, sets the default number of lanes of LanesT.
+#if defined(__AVX512F__)
+#   define PNC_LANE_REGISTER_BYTES 64
+#elif defined(__AVX__) || PLATFORM_ALWAYS_HAS_AVX
+#   define PNC_LANE_REGISTER_BYTES 32
+#else
+#   define PNC_LANE_REGISTER_BYTES 16
+#endif
+
+namespace PNC
+{
+    /// <summary>
+    /// Number of lanes of TScalar filling a vector register of the target ISA.
+    /// </summary>
+    template<typename TScalar>
+    constexpr int32 LaneWidthOf = (int32)(PNC_LANE_REGISTER_BYTES / sizeof(TScalar));
+
+    /// <summary>
+    /// Which lanes of a batch are active.
+    /// </summary>
+    /// <typeparam name="TWidth">Number of lanes.</typeparam>
+    template<int32 TWidth>
+    struct LaneMaskT
+    {
+    public:
+        using Self_t = LaneMaskT<TWidth>;
+        static constexpr int32 Width = TWidth;
+
+    public:
+        bool Lanes[TWidth];
+
+    public:
+        /// <summary>
+        /// Mask with the first count lanes active.
+        /// </summary>
+        static FORCEINLINE Self_t FirstN(int32 count)
+        {
+            Self_t mask;
+            for (int32 i = 0; i < TWidth; ++i)
+                mask.Lanes[i] = i < count;
+            return mask;
+        }
+
+        /// <summary>
+        /// Mask with lane i active when bit i is set.
+        /// </summary>
+        static FORCEINLINE Self_t FromBits(uint64 bits)
+        {
+            Self_t mask;
+            for (int32 i = 0; i < TWidth; ++i)
+                mask.Lanes[i] = ((bits >> i) & 1) != 0;
+            return mask;
+        }
+
+        FORCEINLINE bool operator[](int32 lane)const { return Lanes[lane]; }
+
+        FORCEINLINE bool Any()const
+        {
+            bool any = false;
+            for (int32 i = 0; i < TWidth; ++i)
+                any |= Lanes[i];
+            return any;
+        }
+
+        FORCEINLINE bool All()const
+        {
+            bool all = true;
+            for (int32 i = 0; i < TWidth; ++i)
+                all &= Lanes[i];
+            return all;
+        }
+
+        FORCEINLINE Self_t operator&(const Self_t& o)const { Self_t r; for (int32 i = 0; i < TWidth; ++i) r.Lanes[i] = Lanes[i] && o.Lanes[i]; return r; }
+        FORCEINLINE Self_t operator|(const Self_t& o)const { Self_t r; for (int32 i = 0; i < TWidth; ++i) r.Lanes[i] = Lanes[i] || o.Lanes[i]; return r; }
+        FORCEINLINE Self_t operator!()const { Self_t r; for (int32 i = 0; i < TWidth; ++i) r.Lanes[i] = !Lanes[i]; return r; }
+    };
+
+    /// <summary>
+    /// TWidth values of a scalar type processed together.
+    /// Operations are fixed-length loops over the lanes that the compiler maps to the registers of the target ISA.
+    /// </summary>
+    /// <typeparam name="TScalar">float, double or an integer type.</typeparam>
+    /// <typeparam name="TWidth">Number of lanes.</typeparam>
+    template<typename TScalar, int32 TWidth = LaneWidthOf<TScalar>>
+    struct LanesT
+    {
+    public:
+        using Self_t = LanesT<TScalar, TWidth>;
+        using Scalar_t = TScalar;
+        using Mask_t = LaneMaskT<TWidth>;
+        static constexpr int32 Width = TWidth;
+
+    public:
+        alignas(sizeof(TScalar) * TWidth <= 64 ? sizeof(TScalar) * TWidth : 64) TScalar Lanes[TWidth];
+
+    public:
+        LanesT() = default;
+
+        /// <summary>
+        /// Broadcast a value to every lane.
+        /// </summary>
+        FORCEINLINE LanesT(TScalar value)
+        {
+            for (int32 i = 0; i < TWidth; ++i)
+                Lanes[i] = value;
+        }
+
+        FORCEINLINE TScalar& operator[](int32 lane) { return Lanes[lane]; }
+        FORCEINLINE const TScalar& operator[](int32 lane)const { return Lanes[lane]; }
+
+        /// <summary>
+        /// Convert every lane to another scalar type.
+        /// </summary>
+        template<typename TOther>
+        FORCEINLINE LanesT<TOther, TWidth> Cast()const
+        {
+            LanesT<TOther, TWidth> r;
+            for (int32 i = 0; i < TWidth; ++i)
+                r.Lanes[i] = (TOther)Lanes[i];
+            return r;
+        }
+
+#define PNC_LANES_OPERATOR(op) \
+        FORCEINLINE Self_t operator op(const Self_t& o)const { Self_t r; for (int32 i = 0; i < TWidth; ++i) r.Lanes[i] = Lanes[i] op o.Lanes[i]; return r; } \
+        FORCEINLINE Self_t& operator op##=(const Self_t& o) { for (int32 i = 0; i < TWidth; ++i) Lanes[i] = Lanes[i] op o.Lanes[i]; return *this; }
+        PNC_LANES_OPERATOR(+)
+        PNC_LANES_OPERATOR(-)
+        PNC_LANES_OPERATOR(*)
+        PNC_LANES_OPERATOR(/)
+#undef PNC_LANES_OPERATOR
+
+#define PNC_LANES_COMPARISON(op) \
+        FORCEINLINE Mask_t operator op(const Self_t& o)const { Mask_t r; for (int32 i = 0; i < TWidth; ++i) r.Lanes[i] = Lanes[i] op o.Lanes[i]; return r; }
+        PNC_LANES_COMPARISON(<)
+        PNC_LANES_COMPARISON(<=)
+        PNC_LANES_COMPARISON(>)
+        PNC_LANES_COMPARISON(>=)
+        PNC_LANES_COMPARISON(==)
+        PNC_LANES_COMPARISON(!=)
+#undef PNC_LANES_COMPARISON
+
+        FORCEINLINE Self_t operator-()const { Self_t r; for (int32 i = 0; i < TWidth; ++i) r.Lanes[i] = -Lanes[i]; return r; }
+
+        /// <summary>
+        /// Take each lane from a where the mask is active and from b elsewhere.
+        /// </summary>
+        static FORCEINLINE Self_t Select(const Mask_t& mask, const Self_t& a, const Self_t& b)
+        {
+            Self_t r;
+            for (int32 i = 0; i < TWidth; ++i)
+                r.Lanes[i] = mask.Lanes[i] ? a.Lanes[i] : b.Lanes[i];
+            return r;
+        }
+
+        static FORCEINLINE Self_t Min(const Self_t& a, const Self_t& b) { return Select(a < b, a, b); }
+        static FORCEINLINE Self_t Max(const Self_t& a, const Self_t& b) { return Select(a > b, a, b); }
+    };
+
+    /// <summary>
+    /// TWidth 3D vectors processed together, stored as one LanesT per axis.
+    /// Used for components members with X, Y and Z fields such as FVector.
+    /// </summary>
+    template<typename TScalar, int32 TWidth>
+    struct Vector3LanesT
+    {
+    public:
+        using Self_t = Vector3LanesT<TScalar, TWidth>;
+        using Lanes_t = LanesT<TScalar, TWidth>;
+        using Mask_t = LaneMaskT<TWidth>;
+        static constexpr int32 Width = TWidth;
+
+    public:
+        Lanes_t X;
+        Lanes_t Y;
+        Lanes_t Z;
+
+    public:
+        Vector3LanesT() = default;
+
+        FORCEINLINE Vector3LanesT(const Lanes_t& x, const Lanes_t& y, const Lanes_t& z)
+            : X(x)
+            , Y(y)
+            , Z(z)
+        {
+        }
+
+        FORCEINLINE Self_t operator+(const Self_t& o)const { return Self_t(X + o.X, Y + o.Y, Z + o.Z); }
+        FORCEINLINE Self_t operator-(const Self_t& o)const { return Self_t(X - o.X, Y - o.Y, Z - o.Z); }
+        FORCEINLINE Self_t operator*(const Self_t& o)const { return Self_t(X * o.X, Y * o.Y, Z * o.Z); }
+        FORCEINLINE Self_t operator*(const Lanes_t& s)const { return Self_t(X * s, Y * s, Z * s); }
+        FORCEINLINE Self_t operator/(const Lanes_t& s)const { return Self_t(X / s, Y / s, Z / s); }
+        FORCEINLINE Self_t& operator+=(const Self_t& o) { X += o.X; Y += o.Y; Z += o.Z; return *this; }
+        FORCEINLINE Self_t& operator-=(const Self_t& o) { X -= o.X; Y -= o.Y; Z -= o.Z; return *this; }
+
+        FORCEINLINE Lanes_t Dot(const Self_t& o)const { return X * o.X + Y * o.Y + Z * o.Z; }
+        FORCEINLINE Lanes_t LengthSquared()const { return Dot(*this); }
+
+        static FORCEINLINE Self_t Select(const Mask_t& mask, const Self_t& a, const Self_t& b)
+        {
+            return Self_t(Lanes_t::Select(mask, a.X, b.X), Lanes_t::Select(mask, a.Y, b.Y), Lanes_t::Select(mask, a.Z, b.Z));
+        }
+    };
+
+    /// <summary>
+    /// Lane type used to load a component member: LanesT for scalar members, Vector3LanesT for members with X, Y and Z fields.
+    /// </summary>
+    template<typename TMember, int32 TWidth, bool = std::is_arithmetic_v<TMember>>
+    struct LaneTypeT
+    {
+        using Type = LanesT<TMember, TWidth>;
+        static FORCEINLINE Type Zero() { return Type((TMember)0); }
+        static FORCEINLINE void Set(Type& lanes, int32 lane, const TMember& value) { lanes.Lanes[lane] = value; }
+        static FORCEINLINE void Get(const Type& lanes, int32 lane, TMember& value) { value = lanes.Lanes[lane]; }
+    };
+
+    template<typename TMember, int32 TWidth>
+    struct LaneTypeT<TMember, TWidth, false>
+    {
+        using Type = Vector3LanesT<std::remove_cv_t<decltype(TMember::X)>, TWidth>;
+        static FORCEINLINE Type Zero() { typename Type::Lanes_t zero(0); return Type(zero, zero, zero); }
+        static FORCEINLINE void Set(Type& lanes, int32 lane, const TMember& value) { lanes.X.Lanes[lane] = value.X; lanes.Y.Lanes[lane] = value.Y; lanes.Z.Lanes[lane] = value.Z; }
+        static FORCEINLINE void Get(const Type& lanes, int32 lane, TMember& value) { value.X = lanes.X.Lanes[lane]; value.Y = lanes.Y.Lanes[lane]; value.Z = lanes.Z.Lanes[lane]; }
+    };
+
+    /// <summary>
+    /// A batch of up to TWidth Nodes of a Chunk, one per lane, used to write vectorized Execute kernels
+    /// without handling ComponentOwner_Node and ComponentOwner_Chunk columns or the last partial batch by hand.
+    /// Loading a ComponentOwner_Node member gathers it from each Node of the batch,
+    /// loading a ComponentOwner_Chunk member broadcasts it to every lane.
+    /// Lanes past the last Node or not selected are inactive: they load zero and are never stored.
+    /// ex.:
+    ///     void Execute(Size_t nodeCount)
+    ///     {
+    ///         NodeLanes<float>::ForEach(nodeCount, [&](const NodeLanes<float>& batch)
+    ///             {
+    ///                 auto velocity = batch.Load(Velocities, &Velocity::Value);
+    ///                 auto deltaTime = batch.Load(Time, &TimeStep::Seconds).Cast<double>();
+    ///                 batch.Store(Positions, &Position::Value, batch.Load(Positions, &Position::Value) + velocity * deltaTime);
+    ///             });
+    ///     }
+    /// </summary>
+    /// <typeparam name="TSize"></typeparam>
+    /// <typeparam name="TWidth">Number of lanes, at most 64.</typeparam>
+    template<typename TSize, int32 TWidth>
+    struct NodeLanesT
+    {
+    public:
+        using Self_t = NodeLanesT<TSize, TWidth>;
+        using Size_t = TSize;
+        using Mask_t = LaneMaskT<TWidth>;
+        using NodeSelection_t = NodeSelectionT<TSize>;
+        static constexpr int32 Width = TWidth;
+
+        static_assert(TWidth > 0 && TWidth <= 64, "NodeLanesT supports 1 to 64 lanes.");
+
+        template<typename TMember>
+        using Lanes_t = typename LaneTypeT<TMember, TWidth>::Type;
+
+    public:
+        /// <summary>
+        /// Index of the Node of lane 0, or of its entry in Indices.
+        /// </summary>
+        Size_t First;
+
+        /// <summary>
+        /// Number of lanes mapped to Nodes. Lanes from Count are past the last Node.
+        /// </summary>
+        int32 Count;
+
+        /// <summary>
+        /// Active lanes.
+        /// </summary>
+        Mask_t Mask;
+
+        /// <summary>
+        /// Node index of each entry when iterating a list of indices, null when lanes map to consecutive Nodes.
+        /// </summary>
+        const Size_t* Indices;
+
+    public:
+        /// <summary>
+        /// Index in the Chunk of the Node of a lane.
+        /// </summary>
+        FORCEINLINE Size_t GetNodeIndex(int32 lane)const { return Indices == nullptr ? First + lane : Indices[First + lane]; }
+
+        /// <summary>
+        /// Load a member of a component for every lane.
+        /// </summary>
+        /// <param name="column">Component pointer bound by the algorithm's Requirements.</param>
+        /// <param name="member">Member to load, ex.: &Velocity::Value.</param>
+        template<typename TComponent, typename TClass, typename TMember>
+        FORCEINLINE Lanes_t<TMember> Load(const TComponent* column, TMember TClass::* member)const
+        {
+            using LaneType_t = LaneTypeT<TMember, TWidth>;
+            static_assert(std::is_base_of_v<TClass, std::remove_cv_t<TComponent>>, "The member must belong to the component.");
+            Lanes_t<TMember> lanes;
+            if constexpr (TComponent::Owner == ComponentOwner_Chunk)
+            {
+                for (int32 i = 0; i < TWidth; ++i)
+                    LaneType_t::Set(lanes, i, column->*member);
+            }
+            else if (Indices == nullptr && Count == TWidth)
+            {
+                for (int32 i = 0; i < TWidth; ++i)
+                    LaneType_t::Set(lanes, i, column[First + i].*member);
+            }
+            else
+            {
+                // Inactive lanes are zeroed explicitly, a default constructed member such as FVector is uninitialized.
+                lanes = LaneType_t::Zero();
+                for (int32 i = 0; i < Count; ++i)
+                    if (Mask.Lanes[i])
+                        LaneType_t::Set(lanes, i, column[GetNodeIndex(i)].*member);
+            }
+            return lanes;
+        }
+
+        /// <summary>
+        /// Store a member of a component from every active lane.
+        /// </summary>
+        /// <param name="column">Component pointer bound by the algorithm's Requirements, of a ComponentOwner_Node component.</param>
+        /// <param name="member">Member to store, ex.: &Position::Value.</param>
+        /// <param name="lanes">Values to store.</param>
+        template<typename TComponent, typename TClass, typename TMember>
+        FORCEINLINE void Store(TComponent* column, TMember TClass::* member, const Lanes_t<TMember>& lanes)const
+        {
+            Store(column, member, lanes, Mask);
+        }
+
+        /// <summary>
+        /// Store a member of a component from the lanes active in both the batch and a mask.
+        /// </summary>
+        template<typename TComponent, typename TClass, typename TMember>
+        FORCEINLINE void Store(TComponent* column, TMember TClass::* member, const Lanes_t<TMember>& lanes, const Mask_t& mask)const
+        {
+            using LaneType_t = LaneTypeT<TMember, TWidth>;
+            static_assert(std::is_base_of_v<TClass, TComponent>, "The member must belong to the component.");
+            static_assert(TComponent::Owner == ComponentOwner_Node, "Only ComponentOwner_Node components can be stored from lanes.");
+            for (int32 i = 0; i < Count; ++i)
+                if (Mask.Lanes[i] && mask.Lanes[i])
+                    LaneType_t::Get(lanes, i, column[GetNodeIndex(i)].*member);
+        }
+
+        /// <summary>
+        /// Load a field of a split component for every lane. The lanes of a batch are contiguous within a block when
+        /// the batch width divides the block size, so full batches are plain vector loads.
+        /// </summary>
+        /// <param name="column">Split column bound by the algorithm's Requirements.</param>
+        /// <param name="field">Index of the field in the component.</param>
+        template<typename TComponent>
+        FORCEINLINE LanesT<std::remove_cv_t<typename SplitColumnT<TComponent>::Field_t>, TWidth> Load(const SplitColumnT<TComponent>& column, SSIZE_T field)const
+        {
+            LanesT<std::remove_cv_t<typename SplitColumnT<TComponent>::Field_t>, TWidth> lanes;
+            if (Indices == nullptr && Count == TWidth && SplitColumnT<TComponent>::BlockNodes % TWidth == 0 && ((column.Offset + First) & (TWidth - 1)) == 0)
+            {
+                const auto* fields = &column.Field(First, field);
+                for (int32 i = 0; i < TWidth; ++i)
+                    lanes.Lanes[i] = fields[i];
+            }
+            else
+            {
+                for (int32 i = 0; i < TWidth; ++i)
+                    lanes.Lanes[i] = i < Count && Mask.Lanes[i] ? column.Field(GetNodeIndex(i), field) : 0;
+            }
+            return lanes;
+        }
+
+        /// <summary>
+        /// Store a field of a split component from every active lane.
+        /// </summary>
+        template<typename TComponent>
+        FORCEINLINE void Store(const SplitColumnT<TComponent>& column, SSIZE_T field, const LanesT<typename SplitColumnT<TComponent>::Field_t, TWidth>& lanes)const
+        {
+            for (int32 i = 0; i < Count; ++i)
+                if (Mask.Lanes[i])
+                    column.Field(GetNodeIndex(i), field) = lanes.Lanes[i];
+        }
+
+    public:
+        /// <summary>
+        /// Call func(const Self_t& batch) for each batch of TWidth consecutive Nodes, the last one with only its remaining Nodes active.
+        /// </summary>
+        template<typename TFunc>
+        static void ForEach(Size_t nodeCount, TFunc&& func)
+        {
+            Self_t batch;
+            batch.Indices = nullptr;
+            batch.Count = TWidth;
+            batch.Mask = Mask_t::FirstN(TWidth);
+            for (batch.First = 0; batch.First + TWidth <= nodeCount; batch.First += TWidth)
+                func((const Self_t&)batch);
+            if (batch.First < nodeCount)
+            {
+                batch.Count = (int32)(nodeCount - batch.First);
+                batch.Mask = Mask_t::FirstN(batch.Count);
+                func((const Self_t&)batch);
+            }
+        }
+
+        /// <summary>
+        /// Call func(const Self_t& batch) for each batch of selected Nodes.
+        /// A bitmask selection is processed in batches of TWidth consecutive Nodes with the unselected lanes inactive,
+        /// batches without any selected Node are skipped.
+        /// A list of indices is processed in batches of TWidth selected Nodes gathered by index.
+        /// </summary>
+        template<typename TFunc>
+        static void ForEach(const NodeSelection_t& selection, TFunc&& func)
+        {
+            static_assert(64 % TWidth == 0, "Batches of a bitmask selection must not straddle mask words.");
+            Self_t batch;
+            if (selection.IsIndices())
+            {
+                batch.Indices = selection.Indices;
+                for (batch.First = 0; batch.First < selection.IndexCount; batch.First += TWidth)
+                {
+                    batch.Count = (int32)FMath::Min((Size_t)TWidth, selection.IndexCount - batch.First);
+                    batch.Mask = Mask_t::FirstN(batch.Count);
+                    func((const Self_t&)batch);
+                }
+                return;
+            }
+            batch.Indices = nullptr;
+            constexpr uint64 widthBits = TWidth == 64 ? ~uint64(0) : (uint64(1) << TWidth) - 1;
+            for (batch.First = 0; batch.First < selection.NodeCount; batch.First += TWidth)
+            {
+                uint64 bits = (selection.GetWord(batch.First / 64) >> (batch.First & 63)) & widthBits;
+                if (bits == 0)
+                    continue;
+                batch.Count = (int32)FMath::Min((Size_t)TWidth, selection.NodeCount - batch.First);
+                batch.Mask = Mask_t::FromBits(bits);
+                func((const Self_t&)batch);
+            }
+        }
+    };
+}
@@ -0,0 +1,205 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+
+namespace PNC
+{
+    /// <summary>
+    /// Determine what happens to the other Nodes of a Chunk when a Node is removed.
+    /// </summary>
+    enum NodeRemovalMode
+    {
+        /// <summary>
+        /// Removed Nodes are replaced by the last Nodes of the Chunk.
+        /// Node indices change on removal.
+        /// </summary>
+        NodeRemovalMode_SwapAndPop = 0,
+
+        /// <summary>
+        /// Removed Nodes are marked dead in an occupancy bitmap and their slot is reused by the next added Node.
+        /// Node indices are stable until the Chunk is compacted.
+        /// </summary>
+        NodeRemovalMode_Stable = 1,
+    };
+
+    /// <summary>
+    /// Occupancy bitmap and free slot list of a Chunk using NodeRemovalMode_Stable.
+    /// Node i is alive when bit (i % 64) of word (i / 64) is set.
+    /// </summary>
+    /// <typeparam name="TSize"></typeparam>
+    template< typename TSize>
+    struct NodeOccupancyT
+    {
+    public:
+        using Self_t = NodeOccupancyT<TSize>;
+        using Size_t = TSize;
+
+    public:
+        /// <summary>
+        /// One bit per Node of the Chunk's capacity.
+        /// </summary>
+        std::vector<uint64> Bits;
+
+        /// <summary>
+        /// Dead Nodes whose slot can be reused, the last one is reused first.
+        /// </summary>
+        std::vector<Size_t> FreeSlots;
+
+        /// <summary>
+        /// Fraction of dead Nodes over the Node count above which the Chunk is considered fragmented and should be compacted.
+        /// </summary>
+        float CompactionThreshold = 0.25f;
+
+    public:
+        static constexpr Size_t GetWordCount(Size_t nodeCapacity) { return (nodeCapacity + 63) / 64; }
+
+        /// <summary>
+        /// Get the occupancy bitmap.
+        /// </summary>
+        const uint64* GetBits()const { return Bits.data(); }
+
+        /// <summary>
+        /// Number of dead Nodes below the Node count.
+        /// </summary>
+        Size_t GetDeadCount()const { return (Size_t)FreeSlots.size(); }
+
+        /// <summary>
+        /// If enough Nodes are dead that the Chunk should be compacted.
+        /// </summary>
+        /// <param name="nodeCount">Node count of the Chunk, including dead Nodes.</param>
+        bool IsFragmented(Size_t nodeCount)const
+        {
+            return nodeCount > 0 && GetDeadCount() > CompactionThreshold * nodeCount;
+        }
+
+        /// <summary>
+        /// Make the bitmap large enough for a capacity. New bits are dead.
+        /// </summary>
+        void Reserve(Size_t nodeCapacity)
+        {
+            if ((Size_t)Bits.size() < GetWordCount(nodeCapacity))
+                Bits.resize(GetWordCount(nodeCapacity), 0);
+        }
+
+        /// <summary>
+        /// Mark the first Nodes alive and all the others dead and forget all free slots.
+        /// </summary>
+        /// <param name="nodeCapacity">Capacity of the Chunk.</param>
+        /// <param name="aliveCount">Number of alive Nodes at the beginning of the Chunk.</param>
+        void Reset(Size_t nodeCapacity, Size_t aliveCount)
+        {
+            Bits.assign(GetWordCount(nodeCapacity), 0);
+            FreeSlots.clear();
+            SetAlive(0, aliveCount);
+        }
+
+        /// <summary>
+        /// Mark a range of Nodes alive.
+        /// </summary>
+        void SetAlive(Size_t begin, Size_t end)
+        {
+            for (Size_t i = begin; i < end; ++i)
+                Bits[i / 64] |= uint64(1) << (i & 63);
+        }
+
+        bool IsAlive(Size_t nodeIndex)const
+        {
+            return (Bits[nodeIndex / 64] >> (nodeIndex & 63)) & 1;
+        }
+
+        /// <summary>
+        /// Mark a Node dead and keep its slot for reuse.
+        /// </summary>
+        void Kill(Size_t nodeIndex)
+        {
+            assert_pnc(IsAlive(nodeIndex));
+            Bits[nodeIndex / 64] &= ~(uint64(1) << (nodeIndex & 63));
+            FreeSlots.push_back(nodeIndex);
+        }
+
+        /// <summary>
+        /// Mark the most recently killed Node alive again.
+        /// </summary>
+        /// <returns>Index of the revived Node or -1 if there are no dead Nodes.</returns>
+        Size_t ReviveFreeSlot()
+        {
+            if (FreeSlots.empty())
+                return (Size_t)-1;
+            Size_t nodeIndex = FreeSlots.back();
+            FreeSlots.pop_back();
+            Bits[nodeIndex / 64] |= uint64(1) << (nodeIndex & 63);
+            return nodeIndex;
+        }
+
+        /// <summary>
+        /// Build a bitmap of the dead Nodes below a Node count, as expected by ChunkPointerT::RemoveNodesMasked.
+        /// </summary>
+        void GetDeadMask(Size_t nodeCount, std::vector<uint64>& deadMask)const
+        {
+            deadMask.resize(GetWordCount(nodeCount));
+            for (SIZE_T w = 0; w < deadMask.size(); ++w)
+                deadMask[w] = ~Bits[w];
+        }
+
+        /// <summary>
+        /// Call func(begin, end) for each range of consecutive alive Nodes, in increasing order.
+        /// Whole words of alive or dead Nodes are processed at once.
+        /// </summary>
+        /// <param name="bits">Occupancy bitmap.</param>
+        /// <param name="nodeCount">Number of Nodes covered by the bitmap.</param>
+        /// <param name="func">Callable as func(Size_t begin, Size_t end).</param>
+        template<typename TFunc>
+        static void ForEachAliveRange(const uint64* bits, Size_t nodeCount, TFunc&& func)
+        {
+            Size_t rangeBegin = -1;
+            Size_t wordCount = GetWordCount(nodeCount);
+            for (Size_t w = 0; w < wordCount; ++w)
+            {
+                uint64 word = bits[w];
+                if (w == wordCount - 1 && (nodeCount & 63) != 0)
+                    word &= (uint64(1) << (nodeCount & 63)) - 1;
+                Size_t base = w * 64;
+                if (word == ~uint64(0))
+                {
+                    if (rangeBegin < 0)
+                        rangeBegin = base;
+                    continue;
+                }
+                if (word == 0)
+                {
+                    if (rangeBegin >= 0)
+                    {
+                        func(rangeBegin, base);
+                        rangeBegin = -1;
+                    }
+                    continue;
+                }
+                Size_t bit = 0;
+                while (bit < 64)
+                {
+                    if (rangeBegin >= 0)
+                    {
+                        uint64 dead = ~word >> bit;
+                        if (dead == 0)
+                            break;
+                        bit += (Size_t)FPlatformMath::CountTrailingZeros64(dead);
+                        func(rangeBegin, base + bit);
+                        rangeBegin = -1;
+                    }
+                    else
+                    {
+                        uint64 alive = word >> bit;
+                        if (alive == 0)
+                            break;
+                        bit += (Size_t)FPlatformMath::CountTrailingZeros64(alive);
+                        rangeBegin = base + bit;
+                    }
+                }
+            }
+            if (rangeBegin >= 0)
+                func(rangeBegin, nodeCount);
+        }
+    };
+}
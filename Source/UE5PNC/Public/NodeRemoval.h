@@ -0,0 +1,148 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "ComponentType.h"
+#include "Components.h"
+
+namespace PNC
+{
+    /// <summary>
+    /// Plan to remove a batch of Nodes from a Chunk by moving the last surviving Nodes into the removed slots.
+    /// The plan is computed once and then applied to every Component column, one pass per column.
+    /// </summary>
+    /// <typeparam name="TSize"></typeparam>
+    template< typename TSize>
+    struct NodeRemovalT
+    {
+    public:
+        using Self_t = NodeRemovalT<TSize>;
+        using Size_t = TSize;
+
+    public:
+        /// <summary>
+        /// Sorted indices of the removed Nodes.
+        /// </summary>
+        std::vector<Size_t> Removed;
+
+        /// <summary>
+        /// Removed slots below the new Node count, which are filled by a surviving Node from the end.
+        /// </summary>
+        std::vector<Size_t> Holes;
+
+        /// <summary>
+        /// Surviving Nodes at the end of the Chunk moved into Holes. Sources[i] moves to Holes[i].
+        /// </summary>
+        std::vector<Size_t> Sources;
+
+        /// <summary>
+        /// Number of Nodes before the removal.
+        /// </summary>
+        Size_t OldNodeCount = 0;
+
+        /// <summary>
+        /// Number of Nodes after the removal.
+        /// </summary>
+        Size_t NewNodeCount = 0;
+
+    public:
+        /// <summary>
+        /// Plan the removal of a list of Nodes.
+        /// </summary>
+        /// <param name="nodeIndices">Indices of the Nodes to remove, sorted in increasing order without duplicates.</param>
+        /// <param name="count">Number of indices.</param>
+        /// <param name="nodeCount">Number of Nodes in the Chunk.</param>
+        void Build(const Size_t* nodeIndices, Size_t count, Size_t nodeCount)
+        {
+            Removed.assign(nodeIndices, nodeIndices + count);
+            BuildMoves(nodeCount);
+        }
+
+        /// <summary>
+        /// Plan the removal of the Nodes whose bit is set in a bitmask.
+        /// </summary>
+        /// <param name="mask">One bit per Node, Node i is bit (i % 64) of word (i / 64). Must cover nodeCount bits.</param>
+        /// <param name="nodeCount">Number of Nodes in the Chunk.</param>
+        void BuildFromMask(const uint64* mask, Size_t nodeCount)
+        {
+            Removed.clear();
+            Size_t wordCount = (nodeCount + 63) / 64;
+            for (Size_t w = 0; w < wordCount; ++w)
+            {
+                uint64 word = mask[w];
+                if (w == wordCount - 1 && (nodeCount & 63) != 0)
+                    word &= (uint64(1) << (nodeCount & 63)) - 1;
+                while (word != 0)
+                {
+                    Removed.push_back(w * 64 + (Size_t)FPlatformMath::CountTrailingZeros64(word));
+                    word &= word - 1;
+                }
+            }
+            BuildMoves(nodeCount);
+        }
+
+        /// <summary>
+        /// Write the new index of every Node before the removal, or -1 for removed Nodes.
+        /// </summary>
+        /// <param name="remap">Array of at least OldNodeCount elements.</param>
+        void WriteRemap(Size_t* remap)const
+        {
+            for (Size_t i = 0; i < OldNodeCount; ++i)
+                remap[i] = i;
+            for (Size_t removed : Removed)
+                remap[removed] = (Size_t)-1;
+            for (SIZE_T i = 0; i < Sources.size(); ++i)
+                remap[Sources[i]] = Holes[i];
+        }
+
+        /// <summary>
+        /// Fix up CoParentInChunk indices after a removal.
+        /// Nodes whose parent was removed become root Nodes.
+        /// </summary>
+        /// <param name="parents">CoParentInChunk column of the Chunk, already compacted.</param>
+        /// <param name="nodeCount">Number of Nodes after the removal.</param>
+        /// <param name="remap">Remap written by WriteRemap.</param>
+        static void RemapParents(CoParentInChunkT<Size_t>* parents, Size_t nodeCount, const Size_t* remap)
+        {
+            for (Size_t i = 0; i < nodeCount; ++i)
+            {
+                Size_t parent = parents[i].Index;
+                if (parent >= 0)
+                    parents[i].Index = remap[parent];
+            }
+        }
+
+    protected:
+        void BuildMoves(Size_t nodeCount)
+        {
+            OldNodeCount = nodeCount;
+            NewNodeCount = nodeCount - (Size_t)Removed.size();
+            Holes.clear();
+            Sources.clear();
+            SIZE_T removedTail = Removed.size();
+            for (SIZE_T i = 0; i < Removed.size(); ++i)
+            {
+                assert_pnc(Removed[i] >= 0 && Removed[i] < nodeCount);
+                assert_pnc(i == 0 || Removed[i - 1] < Removed[i]);
+                if (Removed[i] < NewNodeCount)
+                    Holes.push_back(Removed[i]);
+                else if (removedTail == Removed.size())
+                    removedTail = i;
+            }
+            // Fill holes in increasing order with the surviving Nodes taken from the end.
+            Size_t source = nodeCount - 1;
+            SIZE_T nextRemoved = Removed.size();
+            for (SIZE_T i = 0; i < Holes.size(); ++i)
+            {
+                while (nextRemoved > removedTail && Removed[nextRemoved - 1] == source)
+                {
+                    --nextRemoved;
+                    --source;
+                }
+                Sources.push_back(source);
+                --source;
+            }
+        }
+    };
+}
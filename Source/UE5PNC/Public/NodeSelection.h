@@ -0,0 +1,239 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "NodeOccupancy.h"
+#include <type_traits>
+
+namespace PNC
+{
+    /// <summary>
+    /// Selects which Nodes of a Chunk an algorithm processes, either as a bitmask or as a sorted list of Node indices.
+    /// A bitmask suits dense selections and SIMD masks, one word per 64 Nodes, Node i being selected when bit (i % 64) of word (i / 64) is set.
+    /// A list of indices suits sparse selections, processed with a dense index loop.
+    /// A selection does not own its memory.
+    /// Algorithms receive the selection in Execute by declaring:
+    ///     void Execute(Size_t nodeCount, const NodeSelectionT<Size_t>& selection)
+    /// See AlgorithmRunnerChunk::TryRunSelected.
+    /// </summary>
+    /// <typeparam name="TSize"></typeparam>
+    template<typename TSize>
+    struct NodeSelectionT
+    {
+    public:
+        using Self_t = NodeSelectionT<TSize>;
+        using Size_t = TSize;
+
+    public:
+        /// <summary>
+        /// One bit per Node when the selection is a bitmask, null otherwise.
+        /// </summary>
+        const uint64* Mask;
+
+        /// <summary>
+        /// Selected Node indices in increasing order without duplicates when the selection is a list, null otherwise.
+        /// </summary>
+        const Size_t* Indices;
+
+        /// <summary>
+        /// Number of indices in Indices.
+        /// </summary>
+        Size_t IndexCount;
+
+        /// <summary>
+        /// Number of Nodes covered by the selection.
+        /// </summary>
+        Size_t NodeCount;
+
+    public:
+        NodeSelectionT()
+            : Mask(nullptr)
+            , Indices(nullptr)
+            , IndexCount(0)
+            , NodeCount(0)
+        {
+        }
+
+        /// <summary>
+        /// Select the Nodes whose bit is set in a bitmask.
+        /// </summary>
+        /// <param name="mask">Bitmask of at least (nodeCount + 63) / 64 words.</param>
+        /// <param name="nodeCount">Number of Nodes covered by the bitmask.</param>
+        static Self_t FromMask(const uint64* mask, Size_t nodeCount)
+        {
+            Self_t selection;
+            selection.Mask = mask;
+            selection.NodeCount = nodeCount;
+            return selection;
+        }
+
+        /// <summary>
+        /// Select the Nodes of a list of indices.
+        /// </summary>
+        /// <param name="indices">Node indices in increasing order without duplicates, all below nodeCount.</param>
+        /// <param name="indexCount">Number of indices.</param>
+        /// <param name="nodeCount">Number of Nodes covered by the selection.</param>
+        static Self_t FromIndices(const Size_t* indices, Size_t indexCount, Size_t nodeCount)
+        {
+            Self_t selection;
+            selection.Indices = indices;
+            selection.IndexCount = indexCount;
+            selection.NodeCount = nodeCount;
+            return selection;
+        }
+
+        bool IsMask()const { return Mask != nullptr; }
+        bool IsIndices()const { return Mask == nullptr; }
+
+        bool IsSelected(Size_t nodeIndex)const
+        {
+            if (IsMask())
+                return (Mask[nodeIndex / 64] >> (nodeIndex & 63)) & 1;
+            return std::binary_search(Indices, Indices + IndexCount, nodeIndex);
+        }
+
+        /// <summary>
+        /// Get a word of 64 Nodes of the selection with the bits past NodeCount cleared. Only for bitmask selections.
+        /// </summary>
+        uint64 GetWord(Size_t wordIndex)const
+        {
+            assert_pnc(IsMask());
+            uint64 word = Mask[wordIndex];
+            if (wordIndex == NodeOccupancyT<Size_t>::GetWordCount(NodeCount) - 1 && (NodeCount & 63) != 0)
+                word &= (uint64(1) << (NodeCount & 63)) - 1;
+            return word;
+        }
+
+        /// <summary>
+        /// Number of selected Nodes.
+        /// </summary>
+        Size_t CountSelected()const
+        {
+            if (IsIndices())
+                return IndexCount;
+            Size_t count = 0;
+            for (Size_t w = 0; w < NodeOccupancyT<Size_t>::GetWordCount(NodeCount); ++w)
+                count += (Size_t)FPlatformMath::CountBits(GetWord(w));
+            return count;
+        }
+
+        /// <summary>
+        /// Call func(nodeIndex) for each selected Node, in increasing order.
+        /// </summary>
+        template<typename TFunc>
+        void ForEach(TFunc&& func)const
+        {
+            if (IsIndices())
+            {
+                for (Size_t i = 0; i < IndexCount; ++i)
+                    func(Indices[i]);
+                return;
+            }
+            for (Size_t w = 0; w < NodeOccupancyT<Size_t>::GetWordCount(NodeCount); ++w)
+            {
+                for (uint64 word = GetWord(w); word != 0; word &= word - 1)
+                    func(w * 64 + (Size_t)FPlatformMath::CountTrailingZeros64(word));
+            }
+        }
+
+        /// <summary>
+        /// Call func(firstNodeIndex, word) for each word of 64 Nodes with at least one selected Node, in increasing order.
+        /// Lets kernels process 64 Nodes at once under a lane mask. Only for bitmask selections.
+        /// </summary>
+        template<typename TFunc>
+        void ForEachWord(TFunc&& func)const
+        {
+            assert_pnc(IsMask());
+            for (Size_t w = 0; w < NodeOccupancyT<Size_t>::GetWordCount(NodeCount); ++w)
+            {
+                uint64 word = GetWord(w);
+                if (word != 0)
+                    func(w * 64, word);
+            }
+        }
+
+        /// <summary>
+        /// Call func(begin, end) for each range of consecutive selected Nodes, in increasing order.
+        /// </summary>
+        template<typename TFunc>
+        void ForEachRange(TFunc&& func)const
+        {
+            if (IsMask())
+            {
+                NodeOccupancyT<Size_t>::ForEachAliveRange(Mask, NodeCount, func);
+                return;
+            }
+            Size_t i = 0;
+            while (i < IndexCount)
+            {
+                Size_t begin = Indices[i];
+                Size_t end = begin + 1;
+                for (++i; i < IndexCount && Indices[i] == end; ++i)
+                    ++end;
+                func(begin, end);
+            }
+        }
+
+        /// <summary>
+        /// Build a bitmask of the Nodes for which a predicate is true.
+        /// </summary>
+        /// <param name="nodeCount">Number of Nodes to test.</param>
+        /// <param name="predicate">Callable as bool predicate(Size_t nodeIndex).</param>
+        /// <param name="outMask">Receives (nodeCount + 63) / 64 words.</param>
+        template<typename TPredicate>
+        static void BuildMask(Size_t nodeCount, TPredicate&& predicate, std::vector<uint64>& outMask)
+        {
+            outMask.assign(NodeOccupancyT<Size_t>::GetWordCount(nodeCount), 0);
+            for (Size_t i = 0; i < nodeCount; ++i)
+                outMask[i / 64] |= uint64(predicate(i) ? 1 : 0) << (i & 63);
+        }
+
+        /// <summary>
+        /// Build the sorted list of the Nodes for which a predicate is true.
+        /// </summary>
+        /// <param name="nodeCount">Number of Nodes to test.</param>
+        /// <param name="predicate">Callable as bool predicate(Size_t nodeIndex).</param>
+        /// <param name="outIndices">Receives the selected Node indices.</param>
+        template<typename TPredicate>
+        static void BuildIndices(Size_t nodeCount, TPredicate&& predicate, std::vector<Size_t>& outIndices)
+        {
+            outIndices.clear();
+            for (Size_t i = 0; i < nodeCount; ++i)
+                if (predicate(i))
+                    outIndices.push_back(i);
+        }
+
+        /// <summary>
+        /// Remove the dead Nodes of an occupancy bitmap from a selection.
+        /// </summary>
+        /// <param name="occupancy">Occupancy bitmap covering NodeCount Nodes.</param>
+        /// <param name="maskStorage">Storage of the result if the selection is a bitmask.</param>
+        /// <param name="indexStorage">Storage of the result if the selection is a list of indices.</param>
+        /// <returns>The selection of alive selected Nodes, pointing to one of the storages.</returns>
+        Self_t Intersect(const uint64* occupancy, std::vector<uint64>& maskStorage, std::vector<Size_t>& indexStorage)const
+        {
+            if (IsMask())
+            {
+                maskStorage.resize(NodeOccupancyT<Size_t>::GetWordCount(NodeCount));
+                for (SIZE_T w = 0; w < maskStorage.size(); ++w)
+                    maskStorage[w] = Mask[w] & occupancy[w];
+                return FromMask(maskStorage.data(), NodeCount);
+            }
+            indexStorage.clear();
+            for (Size_t i = 0; i < IndexCount; ++i)
+                if ((occupancy[Indices[i] / 64] >> (Indices[i] & 63)) & 1)
+                    indexStorage.push_back(Indices[i]);
+            return FromIndices(indexStorage.data(), (Size_t)indexStorage.size(), NodeCount);
+        }
+    };
+
+    /// <summary>
+    /// If an algorithm's Execute takes a NodeSelectionT and processes the selected Nodes itself.
+    /// </summary>
+    template<typename TAlgorithm, typename TSize, typename = void>
+    struct HasSelectionExecute : std::false_type {};
+
+    template<typename TAlgorithm, typename TSize>
+    struct HasSelectionExecute<TAlgorithm, TSize, std::void_t<decltype(std::declval<TAlgorithm&>().Execute(TSize(), std::declval<const NodeSelectionT<TSize>&>()))>> : std::true_type {};
+}
@@ -24,14 +24,20 @@
 #include "ComponentType.h"
 #include "ComponentTypeSet.h"
 #include "ChunkStructure.h"
+#include "StaticChunkStructure.h"
 #include "ChunkPointer.h"
 #include "ChunkAllocation.h"
+#include "ChunkSlice.h"
+#include "NodeLanes.h"
 #include "ChunkArrayPointer.h"
 #include "ChunkArrayAllocation.h"
+#include "ChunkPool.h"
+#include "ChunkArena.h"
 #include "KindPointer.h"
 #include "KChunkArrayPointer.h"
 #include "Algorithm.h"
 #include "Pipeline.h"
+#include "ChunkHierarchy.h"
 #include "Components.h"
 #include "routing\AlgorithmRouter.h"
 #include "routing\AlgorithmCacheRouter.h"
@@ -43,15 +49,38 @@ namespace PNC
     using ComponentType = ComponentTypeT<Size_t>;
     using ComponentTypeSet = ComponentTypeSetT<Size_t>;
     using ChunkStructure = ChunkStructureT<Size_t>;
+    template<typename... TComponents>
+    using StaticChunkStructure = StaticChunkStructureT<Size_t, TComponents...>;
+    using ChunkLayout = ChunkLayoutT<Size_t>;
+    using NodeRemoval = NodeRemovalT<Size_t>;
+    using NodeOccupancy = NodeOccupancyT<Size_t>;
+    using NodeSelection = NodeSelectionT<Size_t>;
+    template<typename TScalar>
+    using NodeLanes = NodeLanesT<Size_t, LaneWidthOf<TScalar>>;
+    template<typename TComponent>
+    using AlignedColumn = AlignedColumnT<TComponent, ChunkStructure::SimdColumnAlignment>;
 
     using ChunkPointer = ChunkPointerT<ChunkStructure>;
+    using ChunkSlice = ChunkSliceT<ChunkStructure>;
     using Chunk = ChunkAllocationT<ChunkPointerT<ChunkStructure>>;
+    using PooledChunk = ChunkAllocationT<ChunkPointerT<ChunkStructure>, ChunkPoolAllocator>;
+    using TransientChunk = ChunkAllocationT<ChunkPointerT<ChunkStructure>, ChunkArenaAllocator>;
 
     using ChunkArrayPointer = ChunkArrayPointerT<ChunkStructure, ChunkPointer>;
     using ChunkArray = ChunkArrayAllocationT<ChunkArrayPointer>;
 
+    template<typename TStaticChunkStructure>
+    using StaticChunkPointer = ChunkPointerT<TStaticChunkStructure>;
+    template<typename TStaticChunkStructure>
+    using StaticChunk = ChunkAllocationT<ChunkPointerT<TStaticChunkStructure>>;
+    template<typename TStaticChunkStructure>
+    using StaticChunkArrayPointer = ChunkArrayPointerT<TStaticChunkStructure, ChunkPointerT<TStaticChunkStructure>>;
+    template<typename TStaticChunkStructure>
+    using StaticChunkArray = ChunkArrayAllocationT<StaticChunkArrayPointer<TStaticChunkStructure>>;
+
     using KChunkTreePointer = KChunkTreePointerT<ChunkStructure>;
     using KChunkTree = ChunkAllocationT<KChunkTreePointer>;
+    using LinearChunkTree = LinearChunkTreeT<ChunkStructure>;
 
     using KChunkArrayTreePointer = KChunkArrayTreePointerT<ChunkStructure, ChunkPointer>;
     using KChunkArrayTree = ChunkArrayAllocationT< KChunkArrayTreePointer>;
@@ -66,5 +95,7 @@ namespace PNC
 
     using CoParentInChunk = CoParentInChunkT<Size_t>;
     using CoSingleParentOutsideChunk = CoSingleParentOutsideChunkT<Size_t>;
+    using CoParentOutsideChunk = CoParentOutsideChunkT<Size_t>;
     using CoChildrenInChunk = CoChildrenInChunkT<Size_t>;
+    using ChunkHierarchy = ChunkHierarchyT<Size_t>;
 }
\ No newline at end of file
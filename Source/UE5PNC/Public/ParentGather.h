@@ -0,0 +1,146 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "Components.h"
+#include <type_traits>
+
+namespace PNC
+{
+    /// <summary>
+    /// Parent Component values of the Nodes of a Chunk, used in an algorithm's Requirements instead of a raw parent pointer.
+    /// When routed on a Chunk of a tree, the values are fetched from the parent Chunk before Execute:
+    /// - With a CoSingleParentOutsideChunk Component, or a ComponentOwner_Chunk parent Component, every Node shares one value
+    ///   and a single broadcast pointer to the parent Chunk's data is bound, nothing is copied.
+    /// - With a CoParentOutsideChunk Component, the parent value of each Node is gathered into a contiguous scratch column,
+    ///   prefetching a few Nodes ahead and copying from the previous Node when consecutive Nodes share a parent.
+    ///   Values of Nodes whose parent is inside the Chunk (Index of -1) are left unspecified.
+    /// ex.:
+    ///     ParentGatherT<const World> ParentWorlds;
+    ///     template<typename TReq> bool Requirements(TReq req) { return req.Component(Worlds) && req.ParentComponent(ParentWorlds); }
+    ///     void Execute(Size_t nodeCount)
+    ///     {
+    ///         for (Size_t i = 0; i < nodeCount; ++i)
+    ///             Worlds[i].Value = ParentWorlds[i].Value * Locals[i].Value;
+    ///     }
+    /// </summary>
+    /// <typeparam name="TComponent">Parent Component, must be const as the values may be copies.</typeparam>
+    template<typename TComponent>
+    struct ParentGatherT
+    {
+    public:
+        using Self_t = ParentGatherT<TComponent>;
+        using Component_t = TComponent;
+        using Value_t = std::remove_cv_t<TComponent>;
+
+        static_assert(std::is_const_v<TComponent>, "Gathered parent values are copies, declare a ParentGatherT<const T>.");
+
+        /// <summary>
+        /// Number of Nodes ahead whose parent is prefetched while gathering.
+        /// </summary>
+        static constexpr SSIZE_T PrefetchDistance = 8;
+
+    public:
+        /// <summary>
+        /// Parent value of the first Node. The parent value of Node i is Data[i * Stride]. Set by the AlgorithmRequirementFulfiller.
+        /// </summary>
+        TComponent* Data = nullptr;
+
+        /// <summary>
+        /// 1 when the values were gathered per Node, 0 when a single value is broadcast to every Node.
+        /// </summary>
+        SSIZE_T Stride = 0;
+
+    protected:
+        /// <summary>
+        /// Gathered values, one per Node.
+        /// </summary>
+        std::vector<Value_t> Scratch;
+
+    public:
+        ParentGatherT() = default;
+
+        ParentGatherT(const Self_t& o)
+            : Data(o.Data)
+            , Stride(o.Stride)
+            , Scratch(o.Scratch)
+        {
+            Rebind(o);
+        }
+
+        Self_t& operator=(const Self_t& o)
+        {
+            Data = o.Data;
+            Stride = o.Stride;
+            Scratch = o.Scratch;
+            Rebind(o);
+            return *this;
+        }
+
+    public:
+        /// <summary>
+        /// Get the parent value of a Node.
+        /// </summary>
+        /// <param name="index">Node index relative to the first Node the algorithm is executed on.</param>
+        FORCEINLINE TComponent& operator[](SSIZE_T index)const { return Data[index * Stride]; }
+
+        /// <summary>
+        /// If every Node shares the same parent value.
+        /// </summary>
+        bool IsBroadcast()const { return Stride == 0; }
+
+        /// <summary>
+        /// Bind a single parent value shared by every Node.
+        /// </summary>
+        void Broadcast(TComponent* parent)
+        {
+            Data = parent;
+            Stride = 0;
+        }
+
+        /// <summary>
+        /// Fetch the parent value of each Node from the parent Chunk's column.
+        /// Broadcasts instead when every Node has the same parent.
+        /// </summary>
+        /// <param name="parentColumn">Column of the Component in the parent Chunk.</param>
+        /// <param name="parents">Outside parent index of each Node.</param>
+        /// <param name="nodeCount">Number of Nodes.</param>
+        template<typename TSize>
+        void Gather(TComponent* parentColumn, const CoParentOutsideChunkT<TSize>* parents, TSize nodeCount)
+        {
+            TSize first = nodeCount > 0 ? parents[0].Index : -1;
+            TSize i = 1;
+            while (i < nodeCount && parents[i].Index == first)
+                ++i;
+            if (first >= 0 && i == nodeCount)
+            {
+                Broadcast(parentColumn + first);
+                return;
+            }
+            Scratch.resize(nodeCount);
+            TSize previous = -1;
+            for (i = 0; i < nodeCount; ++i)
+            {
+                if (i + PrefetchDistance < nodeCount && parents[i + PrefetchDistance].Index >= 0)
+                    FPlatformMisc::Prefetch(parentColumn + parents[i + PrefetchDistance].Index);
+                TSize parent = parents[i].Index;
+                if (parent >= 0)
+                    Scratch[i] = parent == previous ? Scratch[i - 1] : parentColumn[parent];
+                previous = parent;
+            }
+            Data = Scratch.data();
+            Stride = 1;
+        }
+
+    protected:
+        /// <summary>
+        /// Point to this copy's own scratch column if the copied one pointed to its scratch column.
+        /// </summary>
+        void Rebind(const Self_t& o)
+        {
+            if (o.Stride != 0 && !o.Scratch.empty() && o.Data >= o.Scratch.data() && o.Data <= o.Scratch.data() + o.Scratch.size())
+                Data = Scratch.data() + (o.Data - o.Scratch.data());
+        }
+    };
+}
@@ -5,11 +5,171 @@
 #include "common.h"
 #include "routing\AlgorithmCacheRouter.h"
 #include "routing\AlgorithmMatchStructure.h"
+#include "routing\AlgorithmSignature.h"
+#include "AlgorithmRunnerChunk.h"
+#include "Tasks/Task.h"
+#include <mutex>
 
 namespace PNC
 {
+    /// <summary>
+    /// Accumulate the requirements of every algorithm of a pipeline into a single signature.
+    /// </summary>
+    struct PipelineRequirementSignature
+    {
+    protected:
+        Routing::AlgorithmSignature* Signature;
+
+    public:
+        PipelineRequirementSignature(Routing::AlgorithmSignature* signature)
+            :Signature(signature)
+        {
+        }
+
+        template<typename T>
+        bool Algorithm(T& algorithm)
+        {
+            return algorithm.Requirements(Routing::BuildAlgorithmSignature(Signature));
+        }
+    };
+
+    /// <summary>
+    /// Record the signature of each algorithm of a pipeline, in declaration order.
+    /// </summary>
+    struct PipelineRequirementAccess
+    {
+    protected:
+        std::vector<Routing::AlgorithmSignature>* Signatures;
+
+    public:
+        PipelineRequirementAccess(std::vector<Routing::AlgorithmSignature>* signatures)
+            :Signatures(signatures)
+        {
+        }
+
+        template<typename T>
+        bool Algorithm(T& algorithm)
+        {
+            Signatures->emplace_back();
+            return algorithm.Requirements(Routing::BuildAlgorithmSignature(&Signatures->back()));
+        }
+    };
+
+    /// <summary>
+    /// Collect how to execute each algorithm of a pipeline on a Chunk, in declaration order.
+    /// </summary>
+    template<typename TChunkPointer>
+    struct PipelineCollectExecute
+    {
+    public:
+        struct Entry
+        {
+            void* Algorithm;
+            void (*Execute)(void* algorithm, TChunkPointer& chunkPointer, bool bBound);
+        };
+
+    protected:
+        std::vector<Entry>* Entries;
+
+    public:
+        PipelineCollectExecute(std::vector<Entry>* entries)
+            :Entries(entries)
+        {
+        }
+
+        template<typename T>
+        bool Algorithm(T& algorithm)
+        {
+            Entries->push_back({ &algorithm, [](void* algorithm, TChunkPointer& chunkPointer, bool bBound)
+                {
+                    if (bBound)
+                        AlgorithmRunnerChunk<T, TChunkPointer>::ExecuteNodes(*(T*)algorithm, *chunkPointer);
+                    else
+                        AlgorithmRunnerChunk<T, TChunkPointer>::TryRun(*(T*)algorithm, chunkPointer);
+                } });
+            return true;
+        }
+    };
+
+    /// <summary>
+    /// Route every algorithm of a pipeline to a Chunk, appending their component type indices to a single route.
+    /// </summary>
+    template<typename TChunkPointer, typename TSize, typename TRoute>
+    struct PipelineRouteToCache
+    {
+    public:
+        using AlgorithmRouteToCache_t = Routing::RouteAlgorithmToCacheT<TChunkPointer, TSize, TRoute>;
+
+    public:
+        /// <summary>
+        /// False if an algorithm failed for a reason shared by every Chunk of the ChunkStructure, a missing component or alignment.
+        /// </summary>
+        bool MatchForChunk;
+
+    protected:
+        TChunkPointer* ChunkPointer;
+        TRoute* Route;
+
+    public:
+        PipelineRouteToCache(TChunkPointer* chunkPointer, TRoute* route)
+            : MatchForChunk(true)
+            , ChunkPointer(chunkPointer)
+            , Route(route)
+        {
+        }
+
+        template<typename T>
+        bool Algorithm(T& algorithm)
+        {
+            AlgorithmRouteToCache_t routeToCache(ChunkPointer, Route);
+            bool matches = algorithm.template Requirements<AlgorithmRouteToCache_t&>(routeToCache);
+            MatchForChunk &= routeToCache.MatchForChunk;
+            return matches && routeToCache.MatchForChunk;
+        }
+    };
+
+    /// <summary>
+    /// Bind every algorithm of a pipeline to a Chunk from a route filled by PipelineRouteToCache.
+    /// </summary>
+    template<typename TChunkPointer, typename TSize, typename TRoute>
+    struct PipelineRouteWithCache
+    {
+    public:
+        using AlgorithmRouteWithCache_t = Routing::RouteAlgorithmWithCacheT<TChunkPointer, TSize, TRoute>;
+
+    protected:
+        TChunkPointer* ChunkPointer;
+        const TRoute* Route;
+        TSize CurrentComponentRoute;
+
+    public:
+        PipelineRouteWithCache(TChunkPointer* chunkPointer, const TRoute* route)
+            : ChunkPointer(chunkPointer)
+            , Route(route)
+            , CurrentComponentRoute(0)
+        {
+        }
+
+        template<typename T>
+        bool Algorithm(T& algorithm)
+        {
+            AlgorithmRouteWithCache_t router(ChunkPointer, Route, CurrentComponentRoute);
+            bool matches = algorithm.template Requirements<AlgorithmRouteWithCache_t&>(router);
+            CurrentComponentRoute = router.GetCurrentComponentRoute();
+            return matches;
+        }
+    };
+
     /// <summary>
     /// Extend this template struct to write your own pipeline to process Chunks
+    /// TryRun calls the pipeline's Execute on every Chunk matching it. Execute may route each algorithm with AlgorithmRunnerChunk,
+    /// or opt in to the route shared by all algorithms with Bind and ExecuteBound:
+    ///     template<typename TChunkPointer> void Execute(TChunkPointer& chunkPointer)
+    ///     {
+    ///         bool bBound = Bind(chunkPointer);
+    ///         ExecuteBound(Move, chunkPointer, bBound);
+    ///         ExecuteBound(Attach, chunkPointer, bBound);
+    ///     }
     /// </summary>
     /// <typeparam name="TDerivedPipeline">Derived type. ex.: struct MyPipeline : public PipelineT<MyPipeline> {};</typeparam>
     /// <typeparam name="TChunkStructure"></typeparam>
@@ -23,23 +183,51 @@ namespace PNC
         using ChunkStructure_t = TChunkStructure;
         using Size_t = TSize;
 
+        /// <summary>
+        /// Maximum number of Component requirements of all the pipeline's algorithms together.
+        /// </summary>
+        static constexpr int32 MaxRoutedComponents = 128;
+
     protected:
-        using CacheMap_t = std::unordered_map<const ChunkStructure_t*, bool>;
-        mutable CacheMap_t ChunkStructureMatching;
+        using PipelineRoute_t = Routing::RouteT<Size_t, MaxRoutedComponents>;
+        using RouteTable_t = Routing::AlgorithmRouteTableT<ChunkStructure_t, PipelineRoute_t>;
+
+        /// <summary>
+        /// Requirements of all the pipeline's algorithms, built once on the first Match from any thread.
+        /// </summary>
+        Routing::AlgorithmSignature Signature;
+        std::once_flag SignatureBuilt;
+
+        /// <summary>
+        /// Component type indices of every algorithm of the pipeline, one contiguous route per ChunkStructure.
+        /// </summary>
+        mutable RouteTable_t Routes;
+
+        /// <summary>
+        /// For each algorithm of the pipeline, the index of the earlier algorithms it conflicts with and must wait for in TryRunParallel.
+        /// </summary>
+        std::vector<std::vector<int32>> Dependencies;
+        std::once_flag DependenciesBuilt;
 
     public:
+        PipelineT() {}
+
+        /// <summary>
+        /// A copied pipeline builds its own signature and routes.
+        /// </summary>
+        PipelineT(const PipelineT&) {}
+        PipelineT& operator=(const PipelineT&) { return *this; }
 
-        template<typename TChunkStructure>
-        bool Match(const TChunkStructure* chunkStructure)
+
+        /// <summary>
+        /// If a ChunkStructure fulfills the requirements of every algorithm of the pipeline.
+        /// Only a bitset test once the pipeline's signature is built.
+        /// </summary>
+        bool Match(const ChunkStructure_t* chunkStructure)
         {
-            assert(chunkStructure != null);
-            auto iMatching = ChunkStructureMatching.find(chunkStructure);
-            if (iMatching == ChunkStructureMatching.end())
-            {
-                bool bMatch = Impl()->Requirements(PipelineRequirementMatchForStructure<TChunkStructure>(chunkStructure));
-                iMatching = ChunkStructureMatching.insert(iMatching, typename CacheMap_t::value_type(chunkStructure, bMatch));
-            }
-            return iMatching->second;
+            assert_pnc(chunkStructure != nullptr);
+            std::call_once(SignatureBuilt, [this]() { Impl()->Requirements(PipelineRequirementSignature(&Signature)); });
+            return Signature.Match(*chunkStructure);
         }
 
         template<typename TChunkPointer>
@@ -54,6 +242,125 @@ namespace PNC
             return true;
         }
 
+        /// <summary>
+        /// Bind the component pointers of every algorithm of the pipeline to a Chunk.
+        /// The first time a ChunkStructure is seen its component type indices for all algorithms are resolved into a single route,
+        /// later Chunks of the same ChunkStructure bind all algorithms from that route without any lookup.
+        /// A requirement failing for a single Chunk, such as a parent on a root Chunk, is not cached and the next Chunk routes again.
+        /// Called by the pipeline's Execute to opt in, then each algorithm is run with ExecuteBound.
+        /// </summary>
+        /// <returns>If every algorithm's requirements are fulfilled.</returns>
+        template<typename TChunkPointer>
+        bool Bind(TChunkPointer& chunkPointer)
+        {
+            using RouteToCache_t = PipelineRouteToCache<TChunkPointer, Size_t, PipelineRoute_t>;
+            using RouteWithCache_t = PipelineRouteWithCache<TChunkPointer, Size_t, PipelineRoute_t>;
+            const ChunkStructure_t* chunkStructure = &(*chunkPointer).GetChunkStructure();
+            const PipelineRoute_t* route = Routes.Find(chunkStructure);
+            if (route == nullptr)
+            {
+                PipelineRoute_t newRoute;
+                RouteToCache_t routeToCache(&chunkPointer, &newRoute);
+                bool matches = Impl()->template Requirements<RouteToCache_t&>(routeToCache);
+                if (!routeToCache.MatchForChunk)
+                {
+                    newRoute.MarkMismatch();
+                    Routes.Insert(chunkStructure, newRoute);
+                }
+                else if (matches)
+                {
+                    // Only a complete route is cached, a per Chunk failure stops routing the remaining algorithms.
+                    Routes.Insert(chunkStructure, newRoute);
+                }
+                return matches && routeToCache.MatchForChunk;
+            }
+            if (route->IsMismatch())
+                return false;
+            return Impl()->Requirements(RouteWithCache_t(&chunkPointer, route));
+        }
+
+        /// <summary>
+        /// Execute an algorithm of the pipeline on a Chunk, without routing it again if Bind succeeded.
+        /// When another algorithm failed Bind on this Chunk, the algorithm is routed alone so it still runs if its own requirements are fulfilled.
+        /// </summary>
+        /// <param name="bBound">Result of Bind on this Chunk.</param>
+        /// <returns>False if the algorithm was not executed.</returns>
+        template<typename TAlgorithm, typename TChunkPointer>
+        static bool ExecuteBound(TAlgorithm& algorithm, TChunkPointer& chunkPointer, bool bBound = true)
+        {
+            if (!bBound)
+                return AlgorithmRunnerChunk<TAlgorithm, TChunkPointer>::TryRun(algorithm, chunkPointer);
+            return AlgorithmRunnerChunk<TAlgorithm, TChunkPointer>::ExecuteNodes(algorithm, *chunkPointer);
+        }
+
+        /// <summary>
+        /// Run the pipeline's algorithms on a Chunk concurrently, each as a task.
+        /// An algorithm only waits for the earlier algorithms it conflicts with, those writing a component type it reads or writes
+        /// or reading a component type it writes. Requirements declared as const T* are read-only.
+        /// Algorithms are executed in their declaration order in Requirements, the pipeline's Execute is not called.
+        /// Algorithms are bound from the shared route, or routed one by one when an algorithm fails Bind on this Chunk.
+        /// </summary>
+        /// <returns>If the Chunk matches the pipeline.</returns>
+        template<typename TChunkPointer>
+        bool TryRunParallel(TChunkPointer& chunkPointer)
+        {
+            auto& chunk = *chunkPointer;
+            assert_pnc(!chunk.IsNull());
+            if (!Match(&chunk.GetChunkStructure()))
+                return false;
+            ExecuteParallel(chunkPointer, Bind(chunkPointer));
+            return true;
+        }
+
+        /// <summary>
+        /// Execute the algorithms of the pipeline on a Chunk as tasks following their dependencies, see ExecuteBound.
+        /// Returns once every algorithm is done.
+        /// </summary>
+        /// <param name="bBound">Result of Bind on this Chunk.</param>
+        template<typename TChunkPointer>
+        void ExecuteParallel(TChunkPointer& chunkPointer, bool bBound)
+        {
+            using CollectExecute_t = PipelineCollectExecute<TChunkPointer>;
+            const auto& dependencies = GetDependencies();
+            std::vector<typename CollectExecute_t::Entry> entries;
+            Impl()->Requirements(CollectExecute_t(&entries));
+            assert_pnc(entries.size() == dependencies.size());
+            std::vector<UE::Tasks::FTask> tasks(entries.size());
+            std::vector<UE::Tasks::FTask> prerequisites;
+            for (SIZE_T i = 0; i < entries.size(); ++i)
+            {
+                prerequisites.clear();
+                for (int32 dependency : dependencies[i])
+                    prerequisites.push_back(tasks[dependency]);
+                const auto& entry = entries[i];
+                tasks[i] = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&entry, &chunkPointer, bBound]()
+                    {
+                        entry.Execute(entry.Algorithm, chunkPointer, bBound);
+                    }, prerequisites);
+            }
+            for (auto& task : tasks)
+                task.Wait();
+        }
+
+        /// <summary>
+        /// Get for each algorithm of the pipeline the index of the earlier algorithms it conflicts with.
+        /// Built once from the algorithms' signatures on first use from any thread.
+        /// </summary>
+        const std::vector<std::vector<int32>>& GetDependencies()
+        {
+            std::call_once(DependenciesBuilt, [this]()
+                {
+                    std::vector<Routing::AlgorithmSignature> signatures;
+                    Impl()->Requirements(PipelineRequirementAccess(&signatures));
+                    Dependencies.assign(signatures.size(), {});
+                    for (SIZE_T i = 0; i < signatures.size(); ++i)
+                        for (SIZE_T k = 0; k < i; ++k)
+                            if (signatures[i].ConflictsWith(signatures[k]))
+                                Dependencies[i].push_back((int32)k);
+                });
+            return Dependencies;
+        }
+
         template<typename TChunkPointer>
         void TryRun(TChunkPointer* chunkPointer) = delete;
 
@@ -71,26 +378,4 @@ namespace PNC
     private:
         Pipeline_t* Impl() { return (reinterpret_cast<Pipeline_t*>(this)); }
     };
-
-    template<typename TChunkStructure>
-    struct PipelineRequirementMatchForStructure
-    {
-    public:
-        using ChunkStructure_t = TChunkStructure;
-
-    protected:
-        const TChunkStructure* ChunkStructure;
-
-    public:
-        PipelineRequirementMatchForStructure(const TChunkStructure* chunkStructure)
-            :ChunkStructure(chunkStructure)
-        {
-        }
-
-        template<typename T>
-        bool Algorithm(T& algorithm)
-        {
-            return algorithm.Requirements(Routing::AlgorithmMatchStructure<TChunkStructure>(ChunkStructure));
-        }
-    };
-}
\ No newline at end of file
+}
@@ -5,48 +5,77 @@
 #include "common.h"
 #include "SetAlgorithmChunk.h"
 #include "AlgorithmRequirementFulfiller.h"
+#include "AlgorithmRouteTable.h"
 
 namespace PNC::Routing
 {
 
-    template<typename TSize>
+    /// <summary>
+    /// Component type index in the ChunkStructure of each Component requirement of an algorithm, in the order they are requested.
+    /// Stored inline so a route can be copied and read without any allocation or pointer chasing.
+    /// </summary>
+    /// <typeparam name="TSize"></typeparam>
+    /// <typeparam name="TMaxComponents">Maximum number of Component requirements of the routed algorithms.</typeparam>
+    template<typename TSize, int32 TMaxComponents = 16>
     struct RouteT
     {
     public:
-        using Self_t = RouteT<TSize>;
+        using Self_t = RouteT<TSize, TMaxComponents>;
         using Size_t = TSize;
 
+        static constexpr int32 MaxComponents = TMaxComponents;
+
     public:
-        std::vector<Size_t> Components;
+        Size_t Components[MaxComponents];
+        int32 Count = 0;
+        bool bMismatch = false;
 
         Size_t operator[](Size_t routeIndex)const
         {
+            assert_pnc(routeIndex < Count);
             return Components[routeIndex];
         }
 
-        void AddRoute(Size_t componentTypeIndexInChunk)
+        /// <summary>
+        /// Append the component type index of the next Component requirement.
+        /// A route full of MaxComponents requirements is marked as a mismatch, the algorithms requiring more are never routed.
+        /// </summary>
+        /// <returns>False if the route is a mismatch.</returns>
+        bool AddRoute(Size_t componentTypeIndexInChunk)
         {
-            Components.push_back(componentTypeIndexInChunk);
+            assert_pnc(Count < MaxComponents);
+            if (bMismatch || Count == MaxComponents)
+            {
+                MarkMismatch();
+                return false;
+            }
+            Components[Count++] = componentTypeIndexInChunk;
+            return true;
         }
         void MarkMismatch()
         {
-            Components.clear();
+            Count = 0;
+            bMismatch = true;
         }
         bool IsMismatch()const
         {
-            return Components.size() == 0;
+            return bMismatch;
         }
     };
 
-    template<typename TChunkPointer, typename TSize>
+    /// <summary>
+    /// Route an algorithm to a Chunk and append the component type index of each Component requirement to a route.
+    /// </summary>
+    /// <typeparam name="TRoute">Route receiving the indices, may be shared by several algorithms routed one after the other.</typeparam>
+    template<typename TChunkPointer, typename TSize, typename TRoute = RouteT<TSize>>
     struct RouteAlgorithmToCacheT : public SetAlgorithmChunk<TChunkPointer>
     {
     public:
         using Base_t = SetAlgorithmChunk<TChunkPointer>;
-        using Self_t = RouteAlgorithmToCacheT<TChunkPointer, TSize>;
+        using Self_t = RouteAlgorithmToCacheT<TChunkPointer, TSize, TRoute>;
         using ChunkPointer_t = TChunkPointer;
         using Size_t = TSize;
-        using AlgorithmRoute_t = RouteT<Size_t>;
+        using AlgorithmRoute_t = TRoute;
 
     public:
         bool MatchForChunk;
@@ -66,10 +95,8 @@ namespace PNC::Routing
         {
             auto& chunk = this->ChunkPointer->GetChunk();
             const auto& chunkStructure = chunk.GetChunkStructure();
-            auto componentTypeIndexInChunk = chunkStructure.GetComponentTypeIndexInChunk(&typeid(T));
-            Route->AddRoute(componentTypeIndexInChunk);
-
-            if (componentTypeIndexInChunk == -1)
+            auto componentTypeIndexInChunk = chunkStructure.GetComponentTypeIndexInChunk(ComponentRegistry::GetId<T>());
+            if (!Route->AddRoute(componentTypeIndexInChunk) || componentTypeIndexInChunk == -1)
             {
                 component = nullptr;
                 MatchForChunk = false;
@@ -79,37 +106,68 @@ namespace PNC::Routing
             return true;
         }
 
+        template<typename T, SIZE_T TAlignment>
+        bool Component(AlignedColumnT<T, TAlignment>& column)
+        {
+            if (!this->ChunkPointer->GetChunk().GetChunkStructure().GetLayout().IsColumnAligned(TAlignment))
+            {
+                // Alignment is a property of the ChunkStructure so the failure is cached like a missing component.
+                Route->AddRoute(-1);
+                column.Data = nullptr;
+                MatchForChunk = false;
+                return false;
+            }
+            return Component(column.Data);
+        }
+
+        template<typename T>
+        bool Component(SplitColumnT<T>& column)
+        {
+            column.Offset = 0;
+            return Component(column.Data);
+        }
+
     };
 
-    template<typename TChunkPointer, typename TSize>
+    /// <summary>
+    /// Bind an algorithm to a Chunk using the component type indices of a route previously filled by RouteAlgorithmToCacheT.
+    /// </summary>
+    /// <typeparam name="TRoute">Route holding the indices, may be shared by several algorithms bound one after the other.</typeparam>
+    template<typename TChunkPointer, typename TSize, typename TRoute = RouteT<TSize>>
     struct RouteAlgorithmWithCacheT : public SetAlgorithmChunk<TChunkPointer>
     {
     public:
         using Base_t = SetAlgorithmChunk<TChunkPointer>;
-        using Self_t = RouteAlgorithmWithCacheT<TChunkPointer, TSize>;
+        using Self_t = RouteAlgorithmWithCacheT<TChunkPointer, TSize, TRoute>;
         using ChunkPointer_t = TChunkPointer;
         using Size_t = TSize;
-        using AlgorithmRoute_t = typename RouteT<TSize>;
+        using AlgorithmRoute_t = TRoute;
 
     protected:
-        AlgorithmRoute_t* Route;
+        const AlgorithmRoute_t* Route;
         Size_t CurrentComponentRoute;
 
     public:
-        RouteAlgorithmWithCacheT(ChunkPointer_t* chunkPointer, AlgorithmRoute_t* route)
+        /// <param name="firstComponentRoute">Index in the route of the algorithm's first Component requirement.</param>
+        RouteAlgorithmWithCacheT(ChunkPointer_t* chunkPointer, const AlgorithmRoute_t* route, Size_t firstComponentRoute = 0)
             : Base_t(chunkPointer)
             , Route(route)
-            , CurrentComponentRoute(0)
+            , CurrentComponentRoute(firstComponentRoute)
         {
         }
 
+        /// <summary>
+        /// Index in the route following the last Component requirement bound.
+        /// </summary>
+        Size_t GetCurrentComponentRoute()const { return CurrentComponentRoute; }
+
         template<typename T>
         bool Component(T*& component)
         {
             auto componentTypeIndexInChunk = (*Route)[CurrentComponentRoute];
             ++CurrentComponentRoute;
             // Make sure the cache is valid
-            //assert(componentTypeIndexInChunk == Chunk->GetChunkStructure().GetComponentTypeIndexInChunk(&typeid(T)));
+            //assert(componentTypeIndexInChunk == Chunk->GetChunkStructure().GetComponentTypeIndexInChunk(ComponentRegistry::GetId<T>()));
 
             if (componentTypeIndexInChunk == (Size_t)-1)
                 return false;
@@ -119,6 +177,19 @@ namespace PNC::Routing
             return true;
         }
 
+        template<typename T, SIZE_T TAlignment>
+        bool Component(AlignedColumnT<T, TAlignment>& column)
+        {
+            return Component(column.Data);
+        }
+
+        template<typename T>
+        bool Component(SplitColumnT<T>& column)
+        {
+            column.Offset = 0;
+            return Component(column.Data);
+        }
+
     };
 
     /// <summary>
@@ -136,12 +207,15 @@ namespace PNC::Routing
         using Algorithm_t = TAlgorithm;
         using ChunkStructure_t = TChunkStructure;
         using Size_t = TSize;
+        using AlgorithmRoute_t = RouteT<TSize>;
 
     protected:
-        using AlgorithmRoute_t = RouteT<TSize>;
-        using Map_t = std::unordered_map<const ChunkStructure_t*, AlgorithmRoute_t*>;
-        mutable Map_t Cache;
-        mutable std::list<AlgorithmRoute_t> CachedRoutes;
+        using RouteTable_t = AlgorithmRouteTableT<ChunkStructure_t, AlgorithmRoute_t>;
+
+        /// <summary>
+        /// Route of each ChunkStructure seen so far. Lookups are lock-free so a single router can be used from every worker thread.
+        /// </summary>
+        mutable RouteTable_t Routes;
 
     public:
         AlgorithmCacheRouterT() {}
@@ -171,28 +245,35 @@ namespace PNC::Routing
             auto& chunk = *chunkPointer;
             const ChunkStructure_t* chunkStructure = &chunk.GetChunkStructure();
 
-            typename Map_t::iterator i = Cache.find(chunkStructure);
-            if (i == Cache.end())
+            const AlgorithmRoute_t* route = Routes.Find(chunkStructure);
+            if (route == nullptr)
             {
-                CachedRoutes.push_back(AlgorithmRoute_t());
-                AlgorithmRoute_t* route = &CachedRoutes.back();
-                Cache[chunkStructure] = route;
-                AlgorithmRouteToCache_t routeToCache(&chunkPointer, route);
+                // First time this ChunkStructure is seen, possibly on several threads at once. Each thread routes
+                // into its own copy and the first one inserted is kept.
+                AlgorithmRoute_t newRoute;
+                AlgorithmRouteToCache_t routeToCache(&chunkPointer, &newRoute);
                 bool matches = algorithm.template Requirements<AlgorithmRouteToCache_t&>(routeToCache);
                 if (!routeToCache.MatchForChunk)
-                {
-                    route->MarkMismatch();
-                    return false;
-                }
-                return matches;
-            }
-            else
-            {
-                if (i->second->IsMismatch())
-                    return false;
-                AlgorithmRouteWithCache_t router(&chunkPointer, i->second);
-                return algorithm.template Requirements<AlgorithmRouteWithCache_t&>(router);
+                    newRoute.MarkMismatch();
+                // A per Chunk failure leaves the route incomplete, it is not cached and the next Chunk routes again.
+                if (matches || !routeToCache.MatchForChunk)
+                    Routes.Insert(chunkStructure, newRoute);
+                return matches && routeToCache.MatchForChunk;
             }
+            if (route->IsMismatch())
+                return false;
+            AlgorithmRouteWithCache_t router(&chunkPointer, route);
+            return algorithm.template Requirements<AlgorithmRouteWithCache_t&>(router);
+        }
+
+        /// <summary>
+        /// Get the route cached for a ChunkStructure, to bind the algorithm to other Chunks of that structure without routing.
+        /// </summary>
+        /// <returns>The route or nullptr if the ChunkStructure was never routed or does not match the algorithm.</returns>
+        const AlgorithmRoute_t* FindRoute(const ChunkStructure_t* chunkStructure) const
+        {
+            const AlgorithmRoute_t* route = Routes.Find(chunkStructure);
+            return route != nullptr && !route->IsMismatch() ? route : nullptr;
         }
 
         template<typename TChunkPointer>
@@ -7,6 +7,11 @@
 
 namespace PNC::Routing
 {
+    /// <summary>
+    /// Test if a ChunkStructure fulfills an algorithm's requirements, one requirement at a time.
+    /// To match many ChunkStructures against the same algorithm, build its AlgorithmSignature once instead.
+    /// </summary>
+    /// <typeparam name="TChunkStructure"></typeparam>
     template<typename TChunkStructure>
     struct AlgorithmMatchStructure : public AlgorithmRequirementFulfiller
     {
@@ -27,8 +32,22 @@ namespace PNC::Routing
         template<typename T>
         bool Component(T*& component)
         {
-            auto index = ChunkStructure->GetComponentTypeIndexInChunk(&typeid(T));
-            return index >= 0;
+            if constexpr (ChunkStructure_t::bStatic)
+                return ChunkStructure_t::template HasComponent<T>();
+            else
+                return ChunkStructure->GetComponentTypeIndexInChunk(ComponentRegistry::GetId<T>()) >= 0;
+        }
+
+        template<typename T, SIZE_T TAlignment>
+        bool Component(AlignedColumnT<T, TAlignment>& column)
+        {
+            return ChunkStructure->GetLayout().IsColumnAligned(TAlignment) && Component(column.Data);
+        }
+
+        template<typename T>
+        bool Component(SplitColumnT<T>& column)
+        {
+            return Component(column.Data);
         }
 
         template<typename T>
@@ -37,6 +56,12 @@ namespace PNC::Routing
             return true;
         }
 
+        template<typename T>
+        bool ParentComponent(ParentGatherT<T>& gather)
+        {
+            return true;
+        }
+
         template<typename TChunk>
         bool ParentChunk(TChunk*& parent)
         {
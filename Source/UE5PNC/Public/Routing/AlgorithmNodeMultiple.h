@@ -0,0 +1,91 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "AlgorithmRequirementFulfiller.h"
+
+namespace PNC::Routing
+{
+    /// <summary>
+    /// Find the number of Nodes the ranges an algorithm is executed on must start and end on.
+    /// It is the largest NodeMultiple of the algorithm's AlignedColumnT requirements, 1 if it has none.
+    /// Runners executing an algorithm on ranges of a Chunk only split it on multiples of it, see AlignedColumnT.
+    /// Every requirement is accepted and nothing is bound.
+    /// </summary>
+    struct AlgorithmNodeMultiple : public AlgorithmRequirementFulfiller
+    {
+    public:
+        using Base_t = AlgorithmRequirementFulfiller;
+        using Self_t = AlgorithmNodeMultiple;
+
+    protected:
+        SSIZE_T* NodeMultiple;
+
+    public:
+        AlgorithmNodeMultiple(SSIZE_T* nodeMultiple)
+            : NodeMultiple(nodeMultiple)
+        {
+        }
+
+        template<typename T>
+        bool Component(T*& component)
+        {
+            return true;
+        }
+
+        template<typename T, SIZE_T TAlignment>
+        bool Component(AlignedColumnT<T, TAlignment>& column)
+        {
+            *NodeMultiple = FMath::Max(*NodeMultiple, (SSIZE_T)AlignedColumnT<T, TAlignment>::NodeMultiple);
+            return true;
+        }
+
+        template<typename T>
+        bool Component(SplitColumnT<T>& column)
+        {
+            return true;
+        }
+
+        template<typename T>
+        bool ParentComponent(T*& component)
+        {
+            return true;
+        }
+
+        template<typename T>
+        bool ParentComponent(ParentGatherT<T>& gather)
+        {
+            return true;
+        }
+
+        template<typename TSize>
+        bool ChunkIndex(TSize& index)
+        {
+            return true;
+        }
+
+        template<typename TChunk>
+        bool ParentChunk(TChunk*& parent)
+        {
+            return true;
+        }
+
+        template<typename TChunk>
+        bool ChildrenChunk(TChunk*& children)
+        {
+            return true;
+        }
+    };
+
+    /// <summary>
+    /// Get the number of Nodes the ranges an algorithm is executed on must start and end on, see AlgorithmNodeMultiple.
+    /// </summary>
+    template<typename TAlgorithm>
+    SSIZE_T GetAlgorithmNodeMultiple(TAlgorithm& algorithm)
+    {
+        SSIZE_T nodeMultiple = 1;
+        algorithm.Requirements(AlgorithmNodeMultiple(&nodeMultiple));
+        return nodeMultiple;
+    }
+}
@@ -0,0 +1,164 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include <atomic>
+
+namespace PNC::Routing
+{
+    /// <summary>
+    /// Flat open-addressing table of routes keyed by ChunkStructure pointer.
+    /// Lookups are lock-free and can run on any number of threads while another thread inserts.
+    /// Inserts are serialized by a lock and only happen the first time a ChunkStructure is seen.
+    /// Routes are stored inline in the table and never move or get freed until the table is destroyed,
+    /// so a pointer returned by Find or Insert stays valid for the lifetime of the table.
+    /// </summary>
+    /// <typeparam name="TChunkStructure"></typeparam>
+    /// <typeparam name="TRoute">Trivially copyable route type.</typeparam>
+    template<typename TChunkStructure, typename TRoute>
+    struct AlgorithmRouteTableT
+    {
+    public:
+        using Self_t = AlgorithmRouteTableT<TChunkStructure, TRoute>;
+        using ChunkStructure_t = TChunkStructure;
+        using Route_t = TRoute;
+
+        static constexpr SIZE_T InitialCapacity = 16;
+
+    protected:
+        struct Entry
+        {
+            /// <summary>
+            /// Published last with release semantic once Route is written. nullptr for free entries.
+            /// </summary>
+            std::atomic<const ChunkStructure_t*> Key;
+            Route_t Route;
+        };
+
+        /// <summary>
+        /// A power of two sized array of entries. Growing creates a larger table and keeps the previous
+        /// ones alive so readers that loaded them can finish their lookup.
+        /// </summary>
+        struct Table
+        {
+            SIZE_T Mask;
+            Entry* Entries;
+            Table* Previous;
+        };
+
+        std::atomic<Table*> Current;
+        FCriticalSection InsertLock;
+        SIZE_T Count;
+
+    public:
+        AlgorithmRouteTableT()
+            : Current(nullptr)
+            , Count(0)
+        {
+        }
+
+        AlgorithmRouteTableT(const AlgorithmRouteTableT&) = delete;
+        AlgorithmRouteTableT& operator=(const AlgorithmRouteTableT&) = delete;
+
+        ~AlgorithmRouteTableT()
+        {
+            Table* table = Current.load(std::memory_order_relaxed);
+            while (table != nullptr)
+            {
+                Table* previous = table->Previous;
+                delete[] table->Entries;
+                delete table;
+                table = previous;
+            }
+        }
+
+    public:
+        /// <summary>
+        /// Find the route of a ChunkStructure without taking any lock.
+        /// </summary>
+        /// <returns>The route or nullptr if the ChunkStructure was never inserted.</returns>
+        const Route_t* Find(const ChunkStructure_t* chunkStructure)const
+        {
+            const Table* table = Current.load(std::memory_order_acquire);
+            if (table == nullptr)
+                return nullptr;
+            for (SIZE_T i = Hash(chunkStructure) & table->Mask;; i = (i + 1) & table->Mask)
+            {
+                const Entry& entry = table->Entries[i];
+                const ChunkStructure_t* key = entry.Key.load(std::memory_order_acquire);
+                if (key == chunkStructure)
+                    return &entry.Route;
+                if (key == nullptr)
+                    return nullptr;
+            }
+        }
+
+        /// <summary>
+        /// Insert the route of a ChunkStructure. If another thread inserted it first, its route is kept.
+        /// </summary>
+        /// <returns>The route stored in the table.</returns>
+        const Route_t* Insert(const ChunkStructure_t* chunkStructure, const Route_t& route)
+        {
+            assert_pnc(chunkStructure != nullptr);
+            FScopeLock scopeLock(&InsertLock);
+            if (const Route_t* existing = Find(chunkStructure))
+                return existing;
+            Table* table = Current.load(std::memory_order_relaxed);
+            // Keep the load factor under one half so probe sequences stay short.
+            if (table == nullptr || (Count + 1) * 2 > table->Mask + 1)
+                table = Grow(table);
+            ++Count;
+            return Place(table, chunkStructure, route);
+        }
+
+        /// <summary>
+        /// Number of ChunkStructures in the table.
+        /// </summary>
+        SIZE_T GetCount()const { return Count; }
+
+    protected:
+        static SIZE_T Hash(const ChunkStructure_t* chunkStructure)
+        {
+            // Fibonacci hashing spreads the aligned pointer bits over the whole word.
+            return (SIZE_T)(((uint64)(UPTRINT)chunkStructure * 0x9E3779B97F4A7C15ull) >> 32);
+        }
+
+        /// <summary>
+        /// Write a route in a free entry then publish its key.
+        /// </summary>
+        static const Route_t* Place(Table* table, const ChunkStructure_t* chunkStructure, const Route_t& route)
+        {
+            for (SIZE_T i = Hash(chunkStructure) & table->Mask;; i = (i + 1) & table->Mask)
+            {
+                Entry& entry = table->Entries[i];
+                if (entry.Key.load(std::memory_order_relaxed) != nullptr)
+                    continue;
+                entry.Route = route;
+                entry.Key.store(chunkStructure, std::memory_order_release);
+                return &entry.Route;
+            }
+        }
+
+        /// <summary>
+        /// Publish a table twice as large holding every route of the current one.
+        /// Routes are copied, pointers to the routes of the previous table stay valid.
+        /// </summary>
+        Table* Grow(Table* table)
+        {
+            SIZE_T capacity = table == nullptr ? InitialCapacity : (table->Mask + 1) * 2;
+            Table* grown = new Table{ capacity - 1, new Entry[capacity](), table };
+            if (table != nullptr)
+            {
+                for (SIZE_T i = 0; i <= table->Mask; ++i)
+                {
+                    const ChunkStructure_t* key = table->Entries[i].Key.load(std::memory_order_relaxed);
+                    if (key != nullptr)
+                        Place(grown, key, table->Entries[i].Route);
+                }
+            }
+            Current.store(grown, std::memory_order_release);
+            return grown;
+        }
+    };
+}
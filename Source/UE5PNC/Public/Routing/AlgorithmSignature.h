@@ -0,0 +1,168 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "..\ComponentSignature.h"
+#include "AlgorithmRequirementFulfiller.h"
+#include <type_traits>
+
+namespace PNC::Routing
+{
+    /// <summary>
+    /// Everything an algorithm or a pipeline requires from a ChunkStructure, computed once from its requirements.
+    /// Matching a ChunkStructure is then a bitset test instead of a lookup per required component.
+    /// Requirements are assumed to be a conjunction, every requested component being required.
+    /// </summary>
+    struct AlgorithmSignature
+    {
+    public:
+        /// <summary>
+        /// Component types required in the Chunk.
+        /// </summary>
+        ComponentSignature Components;
+
+        /// <summary>
+        /// Largest column alignment required by an AlignedColumnT requirement, 1 if none.
+        /// </summary>
+        SIZE_T ColumnAlignment = 1;
+
+        /// <summary>
+        /// Component types read or written, in the Chunk or in its parent Chunk.
+        /// </summary>
+        ComponentSignature Accesses;
+
+        /// <summary>
+        /// Component types written, those required through a non-const pointer.
+        /// Declare a requirement as const T* to only read it.
+        /// </summary>
+        ComponentSignature Writes;
+
+        /// <summary>
+        /// If whole parent or children Chunks are required, through which any component type may be accessed.
+        /// </summary>
+        bool bUnknownAccess = false;
+
+    public:
+        /// <summary>
+        /// If a ChunkStructure fulfills the signature.
+        /// </summary>
+        template<typename TChunkStructure>
+        bool Match(const TChunkStructure& chunkStructure)const
+        {
+            return chunkStructure.GetSignature().Contains(Components) && chunkStructure.GetLayout().IsColumnAligned(ColumnAlignment);
+        }
+
+        /// <summary>
+        /// If running two algorithms at the same time on the same Chunk could race,
+        /// when one writes a component type the other reads or writes.
+        /// </summary>
+        bool ConflictsWith(const AlgorithmSignature& o)const
+        {
+            return bUnknownAccess || o.bUnknownAccess || Writes.Intersects(o.Accesses) || o.Writes.Intersects(Accesses);
+        }
+
+        /// <summary>
+        /// Get the signature of an algorithm type, computed on first use from a default constructed instance.
+        /// </summary>
+        template<typename TAlgorithm>
+        static const AlgorithmSignature& Of();
+    };
+
+    /// <summary>
+    /// Record the requirements of an algorithm into an AlgorithmSignature.
+    /// Structure independent requirements are accepted and only recorded as accesses.
+    /// </summary>
+    struct BuildAlgorithmSignature : public AlgorithmRequirementFulfiller
+    {
+    public:
+        using Base_t = AlgorithmRequirementFulfiller;
+        using Self_t = BuildAlgorithmSignature;
+
+    protected:
+        AlgorithmSignature* Signature;
+
+    public:
+        BuildAlgorithmSignature(AlgorithmSignature* signature)
+            :Signature(signature)
+        {
+        }
+
+        template<typename T>
+        bool Component(T*& component)
+        {
+            Signature->Components.Add(ComponentRegistry::GetId<T>());
+            RecordAccess<T>();
+            return true;
+        }
+
+        template<typename T, SIZE_T TAlignment>
+        bool Component(AlignedColumnT<T, TAlignment>& column)
+        {
+            Signature->ColumnAlignment = FMath::Max(Signature->ColumnAlignment, TAlignment);
+            return Component(column.Data);
+        }
+
+        template<typename T>
+        bool Component(SplitColumnT<T>& column)
+        {
+            return Component(column.Data);
+        }
+
+        template<typename TSize>
+        bool ChunkIndex(TSize& index)
+        {
+            return true;
+        }
+
+        template<typename T>
+        bool ParentComponent(T*& component)
+        {
+            RecordAccess<T>();
+            return true;
+        }
+
+        template<typename T>
+        bool ParentComponent(ParentGatherT<T>& gather)
+        {
+            return ParentComponent(gather.Data);
+        }
+
+        template<typename TChunk>
+        bool ParentChunk(TChunk*& parent)
+        {
+            Signature->bUnknownAccess = true;
+            return true;
+        }
+
+        template<typename TChunk>
+        bool ChildrenChunk(TChunk*& children)
+        {
+            Signature->bUnknownAccess = true;
+            return true;
+        }
+
+    protected:
+        template<typename T>
+        void RecordAccess()
+        {
+            ComponentId id = ComponentRegistry::GetId<T>();
+            Signature->Accesses.Add(id);
+            if constexpr (!std::is_const_v<T>)
+                Signature->Writes.Add(id);
+        }
+    };
+
+    template<typename TAlgorithm>
+    const AlgorithmSignature& AlgorithmSignature::Of()
+    {
+        static const AlgorithmSignature signature = []()
+            {
+                AlgorithmSignature result;
+                TAlgorithm algorithm;
+                algorithm.Requirements(BuildAlgorithmSignature(&result));
+                return result;
+            }();
+        return signature;
+    }
+}
@@ -0,0 +1,100 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "AlgorithmRequirementFulfiller.h"
+
+namespace PNC::Routing
+{
+    /// <summary>
+    /// Bind an algorithm already routed to a Chunk array to one of the array's element Chunks in constant time,
+    /// using the component type indices of a route filled by RouteAlgorithmToCacheT on the array.
+    /// Unlike OffsetAlgorithmNode, element Chunks can be bound in any order, which lets several workers process an array.
+    /// Parent and children requirements are shared by all the elements and are left as bound on the array.
+    /// </summary>
+    /// <typeparam name="TChunkPointerElement">Element Chunk pointer type of the array.</typeparam>
+    /// <typeparam name="TRoute"></typeparam>
+    template<typename TChunkPointerElement, typename TRoute>
+    struct BindAlgorithmChunkElement : public AlgorithmRequirementFulfiller
+    {
+    public:
+        using Base_t = AlgorithmRequirementFulfiller;
+        using Self_t = BindAlgorithmChunkElement<TChunkPointerElement, TRoute>;
+        using ChunkPointerElement_t = TChunkPointerElement;
+        using Route_t = TRoute;
+        using Size_t = typename TChunkPointerElement::Size_t;
+
+    protected:
+        ChunkPointerElement_t* ChunkPointer;
+        const Route_t* Route;
+        Size_t CurrentComponentRoute;
+        Size_t ElementIndex;
+
+    public:
+        /// <param name="chunkPointer">Element Chunk to bind.</param>
+        /// <param name="route">Route of the algorithm on the array's ChunkStructure.</param>
+        /// <param name="elementIndex">Index of the element Chunk in the array.</param>
+        BindAlgorithmChunkElement(ChunkPointerElement_t* chunkPointer, const Route_t* route, Size_t elementIndex)
+            : ChunkPointer(chunkPointer)
+            , Route(route)
+            , CurrentComponentRoute(0)
+            , ElementIndex(elementIndex)
+        {
+        }
+
+        template<typename T>
+        bool Component(T*& component)
+        {
+            auto componentTypeIndexInChunk = (*Route)[CurrentComponentRoute];
+            ++CurrentComponentRoute;
+            if (componentTypeIndexInChunk == (Size_t)-1)
+                return false;
+            component = (T*)ChunkPointer->GetChunk().GetComponentData(componentTypeIndexInChunk);
+            return true;
+        }
+
+        template<typename T, SIZE_T TAlignment>
+        bool Component(AlignedColumnT<T, TAlignment>& column)
+        {
+            return Component(column.Data);
+        }
+
+        template<typename T>
+        bool Component(SplitColumnT<T>& column)
+        {
+            column.Offset = 0;
+            return Component(column.Data);
+        }
+
+        bool ChunkIndex(Size_t& index)
+        {
+            index = ElementIndex;
+            return true;
+        }
+
+        template<typename T>
+        bool ParentComponent(T*& component)
+        {
+            return true;
+        }
+
+        template<typename T>
+        bool ParentComponent(ParentGatherT<T>& gather)
+        {
+            return true;
+        }
+
+        template<typename TChunk>
+        bool ParentChunk(TChunk*& parent)
+        {
+            return true;
+        }
+
+        template<typename TChunk>
+        bool ChildrenChunk(TChunk*& children)
+        {
+            return true;
+        }
+    };
+}
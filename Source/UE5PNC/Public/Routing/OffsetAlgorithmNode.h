@@ -40,12 +40,32 @@ namespace PNC::Routing
             return true;
         }
 
+        template<typename T, SIZE_T TAlignment>
+        bool Component(AlignedColumnT<T, TAlignment>& column)
+        {
+            return Component(column.Data);
+        }
+
+        template<typename T>
+        bool Component(SplitColumnT<T>& column)
+        {
+            column.Offset += NodeOffset;
+            return true;
+        }
+
         template<typename T>
         bool ParentComponent(T*& component)
         {
             return true;
         }
 
+        template<typename T>
+        bool ParentComponent(ParentGatherT<T>& gather)
+        {
+            gather.Data += NodeOffset * gather.Stride;
+            return true;
+        }
+
         template<typename TChunk>
         bool ParentChunk(TChunk*& parent)
         {
@@ -32,13 +32,22 @@ namespace PNC::Routing
         template<typename T>
         bool Component(T*& component)
         {
-            auto& chunk = ChunkPointer->GetChunk();
-            const auto& chunkStructure = chunk.GetChunkStructure();
-            auto index = chunkStructure.GetComponentTypeIndexInChunk(&typeid(T));
-            if (index < 0)
+            return BindComponent(ChunkPointer->GetChunk(), component);
+        }
+
+        template<typename T, SIZE_T TAlignment>
+        bool Component(AlignedColumnT<T, TAlignment>& column)
+        {
+            if (!ChunkPointer->GetChunk().GetChunkStructure().GetLayout().IsColumnAligned(TAlignment))
                 return false;
-            component = (T*)chunk.GetComponentData(index);
-            return true;
+            return Component(column.Data);
+        }
+
+        template<typename T>
+        bool Component(SplitColumnT<T>& column)
+        {
+            column.Offset = 0;
+            return Component(column.Data);
         }
 
         bool ChunkIndex(Size_t& index)
@@ -53,6 +62,12 @@ namespace PNC::Routing
             return false;
         }
 
+        template<typename T>
+        bool ParentComponent(ParentGatherT<T>& gather)
+        {
+            return false;
+        }
+
         bool ParentChunk(ChunkPointer_t*& parent)
         {
             parent = ChunkPointer->GetParentChunk();
@@ -63,6 +78,35 @@ namespace PNC::Routing
             children = ChunkPointer->GetFirstChildChunk();
             return children != nullptr;
         }
+
+    protected:
+        /// <summary>
+        /// Set a component pointer to a chunk's component data.
+        /// With a StaticChunkStructureT the component index is a compile time constant, otherwise it is looked up in the chunk's structure.
+        /// </summary>
+        template<typename TChunk, typename T>
+        static bool BindComponent(TChunk& chunk, T*& component)
+        {
+            if constexpr (ChunkStructure_t::bStatic)
+            {
+                constexpr Size_t index = ChunkStructure_t::template GetComponentIndex<T>();
+                if constexpr (index < 0)
+                    return false;
+                else
+                {
+                    component = (T*)chunk.GetComponentData(index);
+                    return true;
+                }
+            }
+            else
+            {
+                auto index = chunk.GetChunkStructure().GetComponentTypeIndexInChunk(ComponentRegistry::GetId<T>());
+                if (index < 0)
+                    return false;
+                component = (T*)chunk.GetComponentData(index);
+                return true;
+            }
+        }
     };
 
     /// <summary>
@@ -107,13 +151,39 @@ namespace PNC::Routing
         {
             if (this->ChunkPointer->GetParentChunk() == nullptr)
                 return false;
-            auto& parentChunk = this->ChunkPointer->GetParentChunk()->GetChunk();
-            const auto& chunkStructure = parentChunk.GetChunkStructure();
-            auto index = chunkStructure.GetComponentTypeIndexInChunk(&typeid(T));
-            if (index < 0)
+            return Base_t::BindComponent(this->ChunkPointer->GetParentChunk()->GetChunk(), component);
+        }
+
+        /// <summary>
+        /// Bind the parent values of the chunk's nodes: a broadcast pointer when the chunk has a CoSingleParentOutsideChunk
+        /// or the component is owned by the parent chunk, otherwise values gathered with the chunk's CoParentOutsideChunk indices.
+        /// </summary>
+        template<typename T>
+        bool ParentComponent(ParentGatherT<T>& gather)
+        {
+            T* parentColumn;
+            if (!ParentComponent(parentColumn))
                 return false;
-            component = (T*)parentChunk.GetComponentData(index);
-            return true;
+            if constexpr (T::Owner == ComponentOwner_Chunk)
+            {
+                gather.Broadcast(parentColumn);
+                return true;
+            }
+            else
+            {
+                auto& chunk = this->ChunkPointer->GetChunk();
+                auto singleParent = chunk.template GetComponentData<CoSingleParentOutsideChunkT<Size_t>>();
+                if (singleParent != nullptr)
+                {
+                    gather.Broadcast(parentColumn + singleParent->Index);
+                    return true;
+                }
+                auto parents = chunk.template GetComponentData<CoParentOutsideChunkT<Size_t>>();
+                if (parents == nullptr)
+                    return false;
+                gather.Gather(parentColumn, parents, chunk.GetNodeCount());
+                return true;
+            }
         }
 
         bool ParentChunk(ChunkPointer_t*& parent)
@@ -144,6 +214,16 @@ namespace PNC::Routing
         {
         }
 
+        using Base_t::ParentComponent;
+
+        /// <summary>
+        /// Parent values are not gathered for arrays, whose element chunks do not share the array's first node indices.
+        /// </summary>
+        template<typename T>
+        bool ParentComponent(ParentGatherT<T>& gather)
+        {
+            return false;
+        }
     };
 
 }
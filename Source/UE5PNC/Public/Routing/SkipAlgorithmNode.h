@@ -0,0 +1,87 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "AlgorithmRequirementFulfiller.h"
+
+namespace PNC::Routing
+{
+    /// <summary>
+    /// Move an algorithm's node component pointers forward or backward within the same chunk.
+    /// Chunk component pointers are left untouched as they are shared by all nodes of the chunk.
+    /// </summary>
+    /// <typeparam name="TChunkPointer"></typeparam>
+    template<typename TChunkPointer>
+    struct SkipAlgorithmNode : public AlgorithmRequirementFulfiller
+    {
+    public:
+        using Base_t = AlgorithmRequirementFulfiller;
+        using Self_t = SkipAlgorithmNode<TChunkPointer>;
+        using ChunkPointer_t = TChunkPointer;
+        using Size_t = typename TChunkPointer::Size_t;
+
+    protected:
+        Size_t NodeOffset;
+
+    public:
+        SkipAlgorithmNode(Size_t nodeOffset)
+            : NodeOffset(nodeOffset)
+        {
+        }
+
+        template<typename T>
+        bool Component(T*& component)
+        {
+            if (T::Owner == ComponentOwner_Node)
+                component += NodeOffset;
+            return true;
+        }
+
+        template<typename T, SIZE_T TAlignment>
+        bool Component(AlignedColumnT<T, TAlignment>& column)
+        {
+            Component(column.Data);
+            // Runners only split Chunks on NodeMultiple boundaries for algorithms with AlignedColumnT requirements.
+            assert_pnc(IsAligned(column.Data, TAlignment));
+            return true;
+        }
+
+        template<typename T>
+        bool Component(SplitColumnT<T>& column)
+        {
+            column.Offset += NodeOffset;
+            return true;
+        }
+
+        template<typename T>
+        bool ParentComponent(T*& component)
+        {
+            return true;
+        }
+
+        template<typename T>
+        bool ParentComponent(ParentGatherT<T>& gather)
+        {
+            gather.Data += NodeOffset * gather.Stride;
+            return true;
+        }
+
+        template<typename TChunk>
+        bool ParentChunk(TChunk*& parent)
+        {
+            return true;
+        }
+
+        template<typename TChunk>
+        bool ChildrenChunk(TChunk*& children)
+        {
+            return true;
+        }
+
+        bool ChunkIndex(Size_t& index)
+        {
+            return true;
+        }
+    };
+}
@@ -0,0 +1,126 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "ComponentType.h"
+#include "Components.h"
+#include <type_traits>
+
+namespace PNC
+{
+    /// <summary>
+    /// Inherit of this struct to declare a Node Component whose column is split by field in blocks of Nodes (AoSoA).
+    /// The column holds blocks of TBlockNodes Nodes, in which the first field of every Node comes first, then the second field, and so on.
+    /// The same field of consecutive Nodes is contiguous so kernels load it into vector lanes without shuffles.
+    /// The component must be trivially copyable and destructible and made only of TField values, ex. an FVector is 3 double fields.
+    /// New Nodes receive the fields of a default constructed instance, so default member initializers are supported.
+    /// Algorithms access a split component through a SplitColumnT requirement, never a raw pointer.
+    /// ex.:
+    ///     struct Position : public SplitNodeComponent<double, 8> { FVector Value; };
+    /// </summary>
+    /// <typeparam name="TField">Type of every field of the component.</typeparam>
+    /// <typeparam name="TBlockNodes">Number of Nodes per block, a power of two of at most 64.</typeparam>
+    template<typename TField, int32 TBlockNodes>
+    struct SplitNodeComponent : public NodeComponent
+    {
+    public:
+        using SplitField_t = TField;
+        static constexpr int32 SplitBlockNodes = TBlockNodes;
+
+        static_assert(TBlockNodes > 0 && TBlockNodes <= 64 && (TBlockNodes & (TBlockNodes - 1)) == 0, "SplitNodeComponent block must be a power of two of at most 64 Nodes.");
+    };
+
+    /// <summary>
+    /// Typed handle to the column of a SplitNodeComponent, used in an algorithm's Requirements instead of a raw pointer.
+    /// Nodes are addressed relative to the first Node the algorithm is executed on, like a raw pointer.
+    /// ex.:
+    ///     SplitColumnT<Position> Positions;
+    ///     SplitColumnT<const Velocity> Velocities;
+    ///     template<typename TReq> bool Requirements(TReq req) { return req.Component(Positions) && req.Component(Velocities); }
+    ///     void Execute(Size_t nodeCount)
+    ///     {
+    ///         for (Size_t i = 0; i < nodeCount; ++i)
+    ///             for (int32 f = 0; f < 3; ++f)
+    ///                 Positions.Field(i, f) += Velocities.Field(i, f);
+    ///     }
+    /// When executed on whole blocks, GetBlockField gives the contiguous lanes of a field for vector loops.
+    /// </summary>
+    /// <typeparam name="TComponent">A SplitNodeComponent, may be const.</typeparam>
+    template<typename TComponent>
+    struct SplitColumnT
+    {
+    public:
+        using Self_t = SplitColumnT<TComponent>;
+        using Component_t = TComponent;
+        using Field_t = std::conditional_t<std::is_const_v<TComponent>, const typename TComponent::SplitField_t, typename TComponent::SplitField_t>;
+
+        static constexpr SSIZE_T BlockNodes = TComponent::SplitBlockNodes;
+        static constexpr SSIZE_T FieldCount = sizeof(TComponent) / sizeof(Field_t);
+
+        static_assert(sizeof(TComponent) % sizeof(Field_t) == 0, "A SplitNodeComponent must only hold fields of its field type.");
+        static_assert(std::is_trivially_copyable_v<std::remove_cv_t<TComponent>> && std::is_trivially_destructible_v<std::remove_cv_t<TComponent>>, "A SplitNodeComponent must be trivially copyable and destructible.");
+
+    public:
+        /// <summary>
+        /// Beginning of the column, always on a block boundary. Set by the AlgorithmRequirementFulfiller.
+        /// </summary>
+        TComponent* Data = nullptr;
+
+        /// <summary>
+        /// Index in the column of the Node addressed as 0. Moved by the AlgorithmRequirementFulfiller.
+        /// </summary>
+        SSIZE_T Offset = 0;
+
+    public:
+        /// <summary>
+        /// Get a field of a Node.
+        /// </summary>
+        /// <param name="index">Node index relative to the first Node the algorithm is executed on.</param>
+        /// <param name="field">Index of the field in the component.</param>
+        FORCEINLINE Field_t& Field(SSIZE_T index, SSIZE_T field)const
+        {
+            SSIZE_T node = Offset + index;
+            return GetBlock(node / BlockNodes)[field * BlockNodes + (node & (BlockNodes - 1))];
+        }
+
+        /// <summary>
+        /// Get the BlockNodes contiguous values of a field in a block.
+        /// </summary>
+        /// <param name="block">Block index relative to the first Node the algorithm is executed on, which must start a block.</param>
+        /// <param name="field">Index of the field in the component.</param>
+        FORCEINLINE Field_t* GetBlockField(SSIZE_T block, SSIZE_T field)const
+        {
+            assert_pnc((Offset & (BlockNodes - 1)) == 0);
+            return GetBlock(Offset / BlockNodes + block) + field * BlockNodes;
+        }
+
+        /// <summary>
+        /// Gather every field of a Node into a component.
+        /// </summary>
+        FORCEINLINE std::remove_cv_t<TComponent> Load(SSIZE_T index)const
+        {
+            std::remove_cv_t<TComponent> component;
+            std::remove_cv_t<Field_t>* fields = (std::remove_cv_t<Field_t>*)&component;
+            for (SSIZE_T f = 0; f < FieldCount; ++f)
+                fields[f] = Field(index, f);
+            return component;
+        }
+
+        /// <summary>
+        /// Scatter every field of a component to a Node.
+        /// </summary>
+        FORCEINLINE void Store(SSIZE_T index, const std::remove_cv_t<TComponent>& component)const
+        {
+            const Field_t* fields = (const Field_t*)&component;
+            for (SSIZE_T f = 0; f < FieldCount; ++f)
+                Field(index, f) = fields[f];
+        }
+
+    protected:
+        FORCEINLINE Field_t* GetBlock(SSIZE_T block)const
+        {
+            return (Field_t*)(Data + block * BlockNodes);
+        }
+    };
+}
@@ -0,0 +1,129 @@
+// MIT License
+// Copyright (c) 2025 Stephanie Rancourt
+
+#pragma once
+#include "common.h"
+#include "ChunkStructure.h"
+#include <type_traits>
+
+namespace PNC
+{
+    /// <summary>
+    /// Get the ComponentType instance of component type T shared by every StaticChunkStructureT of size type TSize.
+    /// </summary>
+    template<typename TSize, typename T>
+    const ComponentTypeT<TSize>* GetStaticComponentType()
+    {
+        static const ComponentTypeT<TSize> componentType((const T*)nullptr, T::Owner);
+        return &componentType;
+    }
+
+    /// <summary>
+    /// A ChunkStructure whose component types are known at compile time.
+    /// Component indices, sizes, alignments and owners are constexpr so chunk pointers and runners instantiated
+    /// with a StaticChunkStructureT as their ChunkStructure type bind component data without any runtime lookup.
+    /// At runtime it is a regular ChunkStructureT and can be used anywhere a ChunkStructureT is expected.
+    /// Use ChunkStructureT for data-driven structures.
+    /// ex.:
+    ///     using MovingStructure = StaticChunkStructure<Position, Velocity>;
+    ///     StaticChunk<MovingStructure> chunk(&MovingStructure::Get(), 1024);
+    /// </summary>
+    /// <typeparam name="TSize"></typeparam>
+    /// <typeparam name="...TComponents">Component types in the order of their index in the structure.</typeparam>
+    template< typename TSize, typename... TComponents>
+    struct StaticChunkStructureT : public ChunkStructureT<TSize>
+    {
+    public:
+        using Base_t = ChunkStructureT<TSize>;
+        using Self_t = StaticChunkStructureT<TSize, TComponents...>;
+        using Size_t = TSize;
+        using ComponentType_t = typename Base_t::ComponentType_t;
+
+        static_assert(sizeof...(TComponents) > 0, "StaticChunkStructureT requires at least one component type.");
+
+        /// <summary>
+        /// The component indices of this structure are known at compile time.
+        /// </summary>
+        static constexpr bool bStatic = true;
+
+        static constexpr Size_t ComponentCount = (Size_t)sizeof...(TComponents);
+        static constexpr Size_t Sizes[] = { (Size_t)sizeof(TComponents)... };
+        static constexpr Size_t Aligns[] = { (Size_t)alignof(TComponents)... };
+        static constexpr ComponentOwner Owners[] = { TComponents::Owner... };
+
+        /// <summary>
+        /// Sum of the size of all ComponentOwner_Node components.
+        /// </summary>
+        static constexpr SIZE_T BytesPerNode = (((TComponents::Owner == ComponentOwner_Node) ? sizeof(TComponents) : 0) + ...);
+
+        /// <summary>
+        /// Sum of the size of all ComponentOwner_Chunk components.
+        /// </summary>
+        static constexpr SIZE_T BytesPerChunk = (((TComponents::Owner == ComponentOwner_Chunk) ? sizeof(TComponents) : 0) + ...);
+
+        /// <summary>
+        /// If every component is trivially copyable and destructible and needs no construction.
+        /// </summary>
+        static constexpr bool bTrivial = ((std::is_trivially_default_constructible_v<TComponents> && std::is_trivially_copyable_v<TComponents> && std::is_trivially_destructible_v<TComponents>) && ...);
+
+    public:
+        /// <summary>
+        /// Get the index of a component type in the structure at compile time.
+        /// </summary>
+        /// <typeparam name="T">Component type, may be const.</typeparam>
+        /// <returns>Index of the component type or -1 if not part of the structure.</returns>
+        template<typename T>
+        static constexpr Size_t GetComponentIndex()
+        {
+            constexpr bool matches[] = { std::is_same_v<std::remove_cv_t<T>, TComponents>... };
+            for (Size_t i = 0; i < ComponentCount; ++i)
+                if (matches[i])
+                    return i;
+            return -1;
+        }
+
+        /// <summary>
+        /// If a component type is part of the structure.
+        /// </summary>
+        template<typename T>
+        static constexpr bool HasComponent() { return GetComponentIndex<T>() >= 0; }
+
+    public:
+        /// <summary>
+        /// Create the structure.
+        /// </summary>
+        /// <param name="columnAlignment">Minimum alignment in bytes of every column, a power of two. See ChunkStructureT.</param>
+        StaticChunkStructureT(Size_t columnAlignment = 1)
+            : Base_t(columnAlignment, { GetComponentType<TComponents>()... })
+        {
+            static_assert(((GetComponentIndex<TComponents>() == FindLastComponentIndex<TComponents>()) && ...), "StaticChunkStructureT component types must be unique.");
+            assert_pnc(this->GetLayout().bTrivial == bTrivial);
+        }
+
+        /// <summary>
+        /// Get the shared instance of this structure, with columns only aligned to their component's alignment.
+        /// </summary>
+        static const Self_t& Get()
+        {
+            static const Self_t instance;
+            return instance;
+        }
+
+        /// <summary>
+        /// Get the ComponentType instance shared by every StaticChunkStructureT using component type T, see GetStaticComponentType.
+        /// </summary>
+        template<typename T>
+        static const ComponentType_t* GetComponentType() { return GetStaticComponentType<TSize, T>(); }
+
+    protected:
+        template<typename T>
+        static constexpr Size_t FindLastComponentIndex()
+        {
+            constexpr bool matches[] = { std::is_same_v<std::remove_cv_t<T>, TComponents>... };
+            for (Size_t i = ComponentCount - 1; i >= 0; --i)
+                if (matches[i])
+                    return i;
+            return -1;
+        }
+    };
+}
@@ -3,6 +3,7 @@
 
 #pragma once
 #include <assert.h>
+#include <algorithm>
 #include <stdexcept>
 #include <typeinfo>
 #include <concepts>